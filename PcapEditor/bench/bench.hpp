@@ -0,0 +1,36 @@
+#pragma once
+#include <defination.hpp>
+#include <attribute.hpp>
+#include <link.hpp>
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace PcapEditor::bench {
+
+    using BenchmarkFunction = std::function<void()>;
+
+    // Registers a benchmark at static initialization time, run them with `pcap_editor_bench [name filter]`
+    struct Registrar {
+        Registrar(std::string name, BenchmarkFunction function);
+    };
+
+    // Runs function `iterations` times and prints the time and heap allocations of the calling thread per iteration
+    void measure(std::string_view label, u32 iterations, const std::function<void()> &function);
+
+    [[nodiscard]] u64 getAllocationCount();
+
+    // Ethernet frames mixing TLS, DNS, HTTP and plain UDP traffic
+    [[nodiscard]] std::vector<std::vector<u8>> makePacketFrames(u32 count);
+
+    inline void connect(Attribute &from, Attribute &to) {
+        Link link(from.getId(), to.getId());
+
+        from.addConnectedAttribute(link.getId(), &to);
+        to.addConnectedAttribute(link.getId(), &from);
+        to.setInputSource(&from);
+    }
+
+}
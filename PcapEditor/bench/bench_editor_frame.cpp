@@ -0,0 +1,255 @@
+#include "bench.hpp"
+
+#include <allocation_counter.hpp>
+#include <concrete_nodes.hpp>
+#include <graph_registry.hpp>
+#include <node_group.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+
+#include <imgui.h>
+#include <imnodes.h>
+
+namespace PcapEditor::bench {
+
+    namespace {
+
+        const ImVec2 DisplaySize(1920, 1080);
+
+        double getTime() {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        // Every registered node type in turn, laid out on a grid and chained output to input where the types allow it.
+        // Runs of groupSize nodes are collapsed into groups.
+        void buildGraph(GraphRegistry &graph, u32 nodeCount, u32 groupSize) {
+            std::vector<const utility::impl::Entry *> entries;
+            for (const auto &entry : utility::getEntries()) {
+                // Devices open a capture when created
+                if (!entry.name.empty() && entry.category != "hex.builtin.nodes.device")
+                    entries.push_back(&entry);
+            }
+
+            std::vector<int> ids;
+            std::vector<ImVec2> positions;
+
+            graph.reserve(nodeCount, nodeCount * 3, nodeCount);
+            for (u32 i = 0; i < nodeCount; i++) {
+                auto node = entries[i % entries.size()]->creatorFunction();
+                graph.addNode(node);
+
+                ids.push_back(node->getId());
+                positions.emplace_back(float(i % 316) * 220, float(i / 316) * 160);
+                ImNodes::SetNodeGridSpacePos(node->getId(), positions.back());
+            }
+
+            const auto &nodes = graph.getNodes();
+            for (u32 i = 0; i + 1 < nodes.size(); i++) {
+                for (auto &from : nodes[i]->getAttributes()) {
+                    if (from.getIOType() != Attribute::IOType::Out)
+                        continue;
+
+                    for (auto &to : nodes[i + 1]->getAttributes()) {
+                        if (to.getIOType() == Attribute::IOType::In && graph.addLink(from.getId(), to.getId()) != nullptr)
+                            break;
+                    }
+                }
+            }
+
+            if (groupSize <= 1)
+                return;
+
+            for (u32 i = 0; i < nodeCount; i += groupSize) {
+                const auto count = std::min(groupSize, nodeCount - i);
+
+                ImVec2 position;
+                auto group = NodeGroup::collapse(graph, std::span(ids).subspan(i, count), std::span(positions).subspan(i, count), position);
+                ImNodes::SetNodeGridSpacePos(group->getId(), position);
+            }
+        }
+
+        void freeGraph(GraphRegistry &graph) {
+            std::vector<int> ids;
+            for (auto node : graph.getNodes())
+                ids.push_back(node->getId());
+
+            for (auto node : graph.eraseNodes(ids))
+                delete node;
+        }
+
+        // One frame of the editor's node view, submitted the way PcapEditor::NodeEditorShow and drawNodeContent do it and rendered into draw data nobody draws
+        void drawFrame(const GraphRegistry &graph, std::unordered_map<u32, ImVec2> &contentSizes, ImVec2 mousePos, bool mouseDown) {
+            auto &io        = ImGui::GetIO();
+            io.MousePos     = mousePos;
+            io.MouseDown[0] = mouseDown;
+            io.DeltaTime    = 1.0F / 60;
+
+            ImGui::NewFrame();
+            ImGui::SetNextWindowPos(ImVec2(0, 0));
+            ImGui::SetNextWindowSize(DisplaySize);
+            ImGui::Begin("##editor", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoSavedSettings);
+
+            ImNodes::BeginNodeEditor();
+
+            for (auto node : graph.getNodes()) {
+                ImNodes::BeginNode(node->getId());
+
+                ImNodes::BeginNodeTitleBar();
+                ImGui::TextUnformatted(node->getUnlocalizedTitle().c_str());
+                ImNodes::EndNodeTitleBar();
+
+                const auto zoom = ImNodes::EditorContextGetZoom();
+                if (ImNodes::IsNodeVisible(node->getId())) {
+                    ImGui::BeginGroup();
+                    node->drawNode();
+                    ImGui::EndGroup();
+
+                    contentSizes[node->getId()] = ImGui::GetItemRectSize() / zoom;
+                } else {
+                    ImGui::Dummy(contentSizes[node->getId()] * zoom);
+                }
+
+                for (auto &attribute : node->getAttributes()) {
+                    if (attribute.getIOType() == Attribute::IOType::In) {
+                        ImNodes::BeginInputAttribute(attribute.getId(), ImNodesPinShape_Circle);
+                        ImGui::TextUnformatted(attribute.getUnlocalizedName().c_str());
+                        ImNodes::EndInputAttribute();
+                    } else {
+                        ImNodes::BeginOutputAttribute(attribute.getId(), ImNodesPinShape_CircleFilled);
+                        ImGui::TextUnformatted(attribute.getUnlocalizedName().c_str());
+                        ImNodes::EndOutputAttribute();
+                    }
+                }
+
+                ImNodes::EndNode();
+            }
+
+            for (const auto &[id, link] : graph.getLinks())
+                ImNodes::Link(link.getId(), link.getFromId(), link.getToId());
+
+            ImNodes::MiniMap(0.2F, ImNodesMiniMapLocation_BottomRight);
+            ImNodes::EndNodeEditor();
+
+            ImGui::End();
+            ImGui::Render();
+        }
+
+        // Where the mouse is in each measured frame. Hovering moves it around the middle of the view. Box selection presses it on
+        // the empty canvas left of the graph and drags it to the bottom right, selecting more nodes every frame.
+        ImVec2 mousePosition(u32 frame, u32 frameCount, bool boxSelection) {
+            if (!boxSelection)
+                return { DisplaySize.x / 2 + float(frame % 8) * 4, DisplaySize.y / 2 };
+
+            const auto progress = float(frame > 0 ? frame - 1 : 0) / float(frameCount);
+            return { 20 + (DisplaySize.x - 40) * progress, 20 + (DisplaySize.y - 40) * progress };
+        }
+
+        void editorFrame(u32 nodeCount, u32 frameCount, u32 groupSize = 1, bool boxSelection = false, float zoom = 1) {
+            auto editor = ImNodes::EditorContextCreate();
+            ImNodes::EditorContextSet(editor);
+            ImNodes::EditorContextResetPanning(ImVec2(100, 100));
+            ImNodes::EditorContextSetZoom(zoom);
+
+            GraphRegistry graph;
+            buildGraph(graph, nodeCount, groupSize);
+
+            std::unordered_map<u32, ImVec2> contentSizes;
+
+            // The first frame creates every node, pin and link in the editor, measure the steady state after it
+            const auto bytes = allocation::getThreadBytes();
+            drawFrame(graph, contentSizes, mousePosition(0, frameCount, boxSelection), false);
+            const auto firstFrameBytes = allocation::getThreadBytes() - bytes;
+
+            ImNodesFrameStats total;
+            double frameTime  = 0;
+            u64 allocations   = allocation::getThreadCount();
+            u64 steadyBytes   = allocation::getThreadBytes();
+            for (u32 frame = 1; frame <= frameCount; frame++) {
+                const auto start = getTime();
+                drawFrame(graph, contentSizes, mousePosition(frame, frameCount, boxSelection), boxSelection);
+                frameTime += getTime() - start;
+
+                const auto &stats = ImNodes::GetFrameStats();
+                total.SubmissionTime += stats.SubmissionTime;
+                total.HoverTime += stats.HoverTime;
+                total.DrawTime += stats.DrawTime;
+                total.InteractionTime += stats.InteractionTime;
+                total.DepthSortTime += stats.DepthSortTime;
+                total.PoolUpdateTime += stats.PoolUpdateTime;
+                total.MergeTime += stats.MergeTime;
+            }
+            allocations = allocation::getThreadCount() - allocations;
+            steadyBytes = allocation::getThreadBytes() - steadyBytes;
+
+            const auto &stats = ImNodes::GetFrameStats();
+            const auto toMilliseconds = [&](double seconds) { return seconds * 1000 / frameCount; };
+
+            std::printf("  %u nodes in %d (%d drawn), %d pins, %d links (%d drawn)%s", nodeCount, stats.NodeCount, stats.DrawnNodeCount, stats.PinCount, stats.LinkCount,
+                stats.DrawnLinkCount, boxSelection ? ", box selecting" : "");
+            if (zoom != 1)
+                std::printf(", zoom %.2f", zoom);
+            std::printf("\n");
+            std::printf("    frame %9.3f ms  submission %9.3f  hover %9.3f  draw %9.3f  interaction %9.3f  depth sort %9.3f  pool update %9.3f  merge %9.3f\n",
+                toMilliseconds(frameTime), toMilliseconds(total.SubmissionTime), toMilliseconds(total.HoverTime), toMilliseconds(total.DrawTime), toMilliseconds(total.InteractionTime),
+                toMilliseconds(total.DepthSortTime), toMilliseconds(total.PoolUpdateTime), toMilliseconds(total.MergeTime));
+            std::printf("    %d draw channels (%d kept), %d draw commands, %d vertices in the canvas, %d in the frame\n", stats.ChannelCount, stats.ChannelCapacity, stats.DrawCmdCount,
+                stats.VertexCount, ImGui::GetDrawData()->TotalVtxCount);
+            std::printf("    %.1f allocations and %.1f KiB per frame, first frame allocated %.1f MiB\n", double(allocations) / frameCount, double(steadyBytes) / frameCount / 1024,
+                double(firstFrameBytes) / (1024 * 1024));
+
+            ImNodes::EditorContextFree(editor);
+            freeGraph(graph);
+        }
+
+        void editorFrames() {
+            if (utility::getEntries().empty())
+                registerNodes();
+
+            // Route ImGui's and imnodes' allocations through operator new so they're counted too
+            ImGui::SetAllocatorFunctions([](size_t size, void *) { return ::operator new(size); }, [](void *pointer, void *) { ::operator delete(pointer); });
+            ImGui::CreateContext();
+            ImNodes::CreateContext();
+
+            auto &io       = ImGui::GetIO();
+            io.DisplaySize = DisplaySize;
+            io.IniFilename = nullptr;
+
+            // No renderer, the font atlas only has to exist. Large draw lists are split like the OpenGL backend allows.
+            io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+            unsigned char *pixels;
+            int width, height;
+            io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+            ImNodes::GetIO().GetTime = &getTime;
+
+            // Fewer frames for the larger graphs to keep the run short
+            editorFrame(1000, 20);
+            editorFrame(10000, 5);
+            editorFrame(100000, 2);
+
+            // The same graphs with every ten nodes collapsed into a group
+            editorFrame(10000, 5, 10);
+            editorFrame(100000, 2, 10);
+
+            // Dragging a selection box instead of hovering
+            editorFrame(10000, 5, 1, true);
+
+            // Zoomed out for an overview, nodes without details
+            editorFrame(10000, 5, 1, false, 0.1F);
+
+            ImNodes::DestroyContext();
+            ImGui::DestroyContext();
+        }
+
+        Registrar s_editorFrame("editor_frame", [] {
+            editorFrames();
+        });
+
+    }
+
+}
@@ -0,0 +1,114 @@
+#include "bench.hpp"
+
+#include <concrete_nodes.hpp>
+#include <graph_file.hpp>
+
+#include <array>
+#include <cstdio>
+#include <nlohmann/json.hpp>
+
+namespace PcapEditor::bench {
+
+    namespace {
+
+        constexpr u32 NodeCount = 10000;
+
+        constexpr std::array NodeTypes = {
+            "hex.builtin.nodes.constants.int",
+            "hex.builtin.nodes.arithmetic.add",
+            "hex.builtin.nodes.buffer.repeat",
+            "hex.builtin.nodes.stream.filter",
+            "hex.builtin.nodes.display.int",
+        };
+
+        // Same mix of node types as a saved graph would have, created the way the editor does
+        void buildGraph(GraphRegistry &graph, GraphFile::Positions &positions) {
+            if (utility::getEntries().empty())
+                registerNodes();
+
+            std::vector<const utility::impl::Entry *> entries;
+            for (auto type : NodeTypes) {
+                for (const auto &entry : utility::getEntries()) {
+                    if (entry.name == type)
+                        entries.push_back(&entry);
+                }
+            }
+
+            for (u32 i = 0; i < NodeCount; i++) {
+                auto node = entries[i % entries.size()]->creatorFunction();
+                graph.addNode(node);
+                positions[node->getId()] = ImVec2(float(i % 100) * 200, float(i / 100) * 150);
+            }
+
+            const auto &nodes = graph.getNodes();
+            for (u32 i = 0; i + 1 < nodes.size(); i++) {
+                for (auto &from : nodes[i]->getAttributes()) {
+                    if (from.getIOType() != Attribute::IOType::Out)
+                        continue;
+
+                    for (auto &to : nodes[i + 1]->getAttributes()) {
+                        if (to.getIOType() == Attribute::IOType::In && graph.addLink(from.getId(), to.getId()) != nullptr)
+                            break;
+                    }
+                    break;
+                }
+            }
+        }
+
+        void freeGraph(GraphRegistry &graph) {
+            std::vector<int> ids;
+            for (auto node : graph.getNodes())
+                ids.push_back(node->getId());
+
+            for (auto node : graph.eraseNodes(ids))
+                delete node;
+        }
+
+        void graphFile() {
+            GraphRegistry graph;
+            GraphFile::Positions positions;
+            buildGraph(graph, positions);
+
+            std::string text;
+            measure("10k nodes, store JSON", 10, [&] {
+                nlohmann::json j;
+                GraphFile::storeJson(graph, positions, j);
+                text = j.dump();
+            });
+
+            std::vector<u8> binary;
+            measure("10k nodes, store binary", 10, [&] {
+                binary = GraphFile::storeBinary(graph, positions);
+            });
+
+            measure("10k nodes, load JSON", 10, [&] {
+                GraphRegistry loaded;
+                GraphFile::Positions loadedPositions;
+                GraphFile::loadJson(nlohmann::json::parse(text), loaded, loadedPositions);
+                freeGraph(loaded);
+            });
+
+            measure("10k nodes, load binary", 10, [&] {
+                GraphRegistry loaded;
+                GraphFile::Positions loadedPositions;
+                GraphFile::loadBinary(binary, loaded, loadedPositions);
+                freeGraph(loaded);
+            });
+
+            GraphRegistry loaded;
+            GraphFile::Positions loadedPositions;
+            GraphFile::loadBinary(binary, loaded, loadedPositions);
+
+            std::printf("  %zu bytes JSON, %zu bytes binary, %zu nodes and %zu links reloaded\n", text.size(), binary.size(), loaded.getNodes().size(), loaded.getLinks().size());
+
+            freeGraph(loaded);
+            freeGraph(graph);
+        }
+
+        Registrar s_graphFile("graph_file", [] {
+            graphFile();
+        });
+
+    }
+
+}
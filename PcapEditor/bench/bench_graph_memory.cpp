@@ -0,0 +1,97 @@
+#include "bench.hpp"
+
+#include <allocation_counter.hpp>
+#include <concrete_nodes.hpp>
+#include <graph_registry.hpp>
+#include <slab_pool.hpp>
+
+#include <cstdio>
+#include <memory>
+
+namespace PcapEditor::bench {
+
+    namespace {
+
+        constexpr u32 NodeCount = 4096;
+
+        Node *createNode(u32 index) {
+            switch (index % 5) {
+                case 0: return new NodeInteger();
+                case 1: return new NodeArithmeticAdd();
+                case 2: return new NodeBufferRepeat();
+                case 3: return new NodePacketFilter();
+                default: return new NodeDisplayInteger();
+            }
+        }
+
+        // Links every node's first output to the first free input of the next node
+        void linkChain(GraphRegistry &graph) {
+            const auto &nodes = graph.getNodes();
+
+            for (u32 i = 0; i + 1 < nodes.size(); i++) {
+                for (auto &from : nodes[i]->getAttributes()) {
+                    if (from.getIOType() != Attribute::IOType::Out)
+                        continue;
+
+                    for (auto &to : nodes[i + 1]->getAttributes()) {
+                        if (to.getIOType() == Attribute::IOType::In && graph.addLink(from.getId(), to.getId()) != nullptr)
+                            break;
+                    }
+                    break;
+                }
+            }
+        }
+
+        void graphMemory() {
+            const auto allocations = allocation::getThreadCount();
+            const auto bytes       = allocation::getThreadBytes();
+            const auto slabBytes   = SlabPool::getInstance().getBytesInUse();
+
+            std::vector<Node *> nodes;
+            nodes.reserve(NodeCount);
+            for (u32 i = 0; i < NodeCount; i++)
+                nodes.push_back(createNode(i));
+
+            std::printf("  %u nodes: %.1f heap allocations, %.1f heap bytes, %.1f slab bytes per node\n", NodeCount,
+                double(allocation::getThreadCount() - allocations) / NodeCount, double(allocation::getThreadBytes() - bytes) / NodeCount,
+                double(SlabPool::getInstance().getBytesInUse() - slabBytes) / NodeCount);
+
+            GraphRegistry graph;
+            for (auto node : nodes)
+                graph.addNode(node);
+            linkChain(graph);
+
+            // What the evaluator does on every snapshot: walk each node's attributes and their connections
+            u64 sum = 0;
+            measure("4096 nodes, walk attributes and connections", 1000, [&] {
+                for (auto node : graph.getNodes()) {
+                    for (auto &attribute : node->getAttributes()) {
+                        for (auto &[linkId, connected] : attribute.getConnectedAttributes())
+                            sum += connected->getId();
+                    }
+                }
+            });
+
+            std::vector<int> ids;
+            for (auto node : graph.getNodes())
+                ids.push_back(node->getId());
+            for (auto node : graph.eraseNodes(ids))
+                delete node;
+
+            measure("4096 nodes, create and delete", 10, [&] {
+                for (u32 i = 0; i < NodeCount; i++)
+                    nodes[i] = createNode(i);
+                for (auto node : nodes)
+                    delete node;
+            });
+
+            std::printf("  checksum %llu\n", static_cast<unsigned long long>(sum));
+        }
+
+        Registrar s_graphMemory("graph_memory", [] {
+            graphMemory();
+        });
+
+    }
+
+}
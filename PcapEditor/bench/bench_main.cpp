@@ -0,0 +1,59 @@
+#include "bench.hpp"
+#include <allocation_counter.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+    std::vector<std::pair<std::string, PcapEditor::bench::BenchmarkFunction>> &getBenchmarks() {
+        static std::vector<std::pair<std::string, PcapEditor::bench::BenchmarkFunction>> benchmarks;
+
+        return benchmarks;
+    }
+
+}
+
+namespace PcapEditor::bench {
+
+    Registrar::Registrar(std::string name, BenchmarkFunction function) {
+        getBenchmarks().emplace_back(std::move(name), std::move(function));
+    }
+
+    u64 getAllocationCount() {
+        return allocation::getThreadCount();
+    }
+
+    void measure(std::string_view label, u32 iterations, const std::function<void()> &function) {
+        // Warm up caches and any lazily grown storage before measuring
+        function();
+
+        const auto allocationsBefore = getAllocationCount();
+        const auto start             = std::chrono::steady_clock::now();
+
+        for (u32 i = 0; i < iterations; i++)
+            function();
+
+        const auto nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        const auto allocations = getAllocationCount() - allocationsBefore;
+
+        std::printf("  %-48.*s %14.1f ns/iter %10.1f allocs/iter\n", int(label.size()), label.data(), nanoseconds / iterations, double(allocations) / iterations);
+    }
+
+}
+
+int main(int argc, char **argv) {
+    const std::string_view filter = argc > 1 ? argv[1] : "";
+
+    for (const auto &[name, function] : getBenchmarks()) {
+        if (name.find(filter) == std::string::npos)
+            continue;
+
+        std::printf("%s\n", name.c_str());
+        function();
+    }
+
+    return EXIT_SUCCESS;
+}
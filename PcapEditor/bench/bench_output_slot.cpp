@@ -0,0 +1,80 @@
+#include "bench.hpp"
+
+#include <concrete_nodes.hpp>
+
+#include <memory>
+#include <optional>
+
+namespace PcapEditor::bench {
+
+    namespace {
+
+        constexpr u32 ChainLength = 1000;
+
+        void arithmeticChain() {
+            std::vector<std::unique_ptr<Node>> nodes;
+
+            auto constant = std::make_unique<NodeInteger>();
+            nlohmann::json data = { { "data", 1 } };
+            constant->load(data);
+
+            Attribute *previous = &constant->getAttributes()[0];
+            for (u32 i = 0; i < ChainLength; i++) {
+                auto add = std::make_unique<NodeArithmeticAdd>();
+
+                connect(*previous, add->getAttributes()[0]);
+                connect(constant->getAttributes()[0], add->getAttributes()[1]);
+
+                previous = &add->getAttributes()[2];
+                nodes.push_back(std::move(add));
+            }
+
+            auto display = std::make_unique<NodeDisplayInteger>();
+            connect(*previous, display->getAttributes()[0]);
+
+            nodes.push_back(std::move(constant));
+            nodes.push_back(std::move(display));
+
+            measure("1000 node add chain, pull evaluation", 1000, [&] {
+                for (auto &node : nodes) {
+                    node->resetOutputData();
+                    node->resetProcessedInputs();
+                }
+
+                nodes.back()->process();
+            });
+        }
+
+        void slotRoundTrip() {
+            std::vector<std::optional<std::vector<u8>>> legacySlots(ChainLength);
+            std::vector<OutputSlot> slots(ChainLength);
+            volatile u64 sink = 0;
+
+            measure("1000 integer writes + reads, optional<vector<u8>>", 1000, [&] {
+                for (u64 i = 0; i < ChainLength; i++) {
+                    std::vector<u8> buffer(sizeof(u64), 0);
+                    std::memcpy(buffer.data(), &i, sizeof(u64));
+                    legacySlots[i] = buffer;
+                }
+
+                for (auto &slot : legacySlots)
+                    sink = sink + *reinterpret_cast<u64 *>(slot->data());
+            });
+
+            measure("1000 integer writes + reads, OutputSlot", 1000, [&] {
+                for (u64 i = 0; i < ChainLength; i++)
+                    slots[i].setInteger(i);
+
+                for (auto &slot : slots)
+                    sink = sink + slot.getInteger();
+            });
+        }
+
+        Registrar s_outputSlot("output_slot", [] {
+            slotRoundTrip();
+            arithmeticChain();
+        });
+
+    }
+
+}
@@ -0,0 +1,124 @@
+#include "bench.hpp"
+
+#include <packet_stream.hpp>
+#include <PacketState.hpp>
+
+#include <cstdio>
+#include <vector>
+
+namespace PcapEditor::bench {
+
+    namespace {
+
+        constexpr u32 PacketCount = 1024;
+
+        void writeU16(std::vector<u8> &frame, size_t offset, u16 value) {
+            frame[offset]     = value >> 8;
+            frame[offset + 1] = value & 0xFF;
+        }
+
+        // Ethernet + IPv4 + TCP/UDP frame with a small payload
+        std::vector<u8> makeIPv4Frame(u8 ipProtocol, u16 srcPort, u16 dstPort, u32 payloadSize, u8 firstPayloadByte) {
+            const size_t l4Size = ipProtocol == 6 ? 20 : 8;
+            std::vector<u8> frame(14 + 20 + l4Size + payloadSize, 0);
+
+            writeU16(frame, 12, 0x0800);
+            frame[14]      = 0x45;
+            frame[14 + 9]  = ipProtocol;
+            frame[14 + 12] = 10;
+            frame[14 + 15] = 1;
+            frame[14 + 16] = 10;
+            frame[14 + 19] = 2;
+
+            writeU16(frame, 34, srcPort);
+            writeU16(frame, 36, dstPort);
+            if (ipProtocol == 6)
+                frame[34 + 12] = 5 << 4;
+
+            if (payloadSize > 0)
+                frame[34 + l4Size] = firstPayloadByte;
+
+            return frame;
+        }
+
+    }
+
+    std::vector<std::vector<u8>> makePacketFrames(u32 count) {
+        std::vector<std::vector<u8>> frames;
+
+        for (u32 i = 0; i < count; i++) {
+            switch (i % 4) {
+                case 0: frames.push_back(makeIPv4Frame(6, 50000 + i, 443, 200, 23)); break;
+                case 1: frames.push_back(makeIPv4Frame(17, 40000 + i, 53, 40, 0)); break;
+                case 2: frames.push_back(makeIPv4Frame(6, 80, 51000 + i, 600, 'H')); break;
+                case 3: frames.push_back(makeIPv4Frame(17, 7000, 7001, 1000, 0)); break;
+            }
+        }
+
+        return frames;
+    }
+
+    namespace {
+
+        void packetBatch() {
+            const auto frames = makePacketFrames(PacketCount);
+            const timespec timestamp = { 0, 0 };
+
+            {
+                pcpp::PacketStats stats;
+
+                measure("1024 packets, pcpp::Packet + consumePacket", 100, [&] {
+                    for (const auto &frame : frames) {
+                        pcpp::RawPacket rawPacket(frame.data(), int(frame.size()), timestamp, false);
+                        pcpp::Packet packet(&rawPacket);
+                        stats.consumePacket(packet);
+                    }
+                });
+            }
+
+            PacketBatch batch;
+            measure("1024 packets, columnar batch build", 100, [&] {
+                batch.clear();
+                for (const auto &frame : frames)
+                    batch.push(frame, u32(frame.size()), timestamp);
+            });
+
+            {
+                pcpp::PacketStats stats;
+
+                measure("1024 packets, consumeProtocols over columns", 1000, [&] {
+                    for (auto protocols : batch.getProtocols())
+                        stats.consumeProtocols(protocols);
+                });
+            }
+
+            std::vector<u32> all(batch.size());
+            for (u32 i = 0; i < all.size(); i++)
+                all[i] = i;
+
+            std::vector<u32> selected;
+            measure("1024 packets, select TCP", 1000, [&] {
+                selected.clear();
+                kernels::selectProtocols(batch, all, pcpp::TCP, selected);
+            });
+
+            u64 bytes = 0;
+            measure("1024 packets, sum wire lengths", 1000, [&] {
+                bytes += kernels::sumWireLengths(batch, all);
+            });
+
+            std::vector<u64> hashes;
+            measure("1024 packets, symmetric 5-tuple hash", 1000, [&] {
+                kernels::hashFlows(batch, all, hashes);
+            });
+
+            std::printf("  %zu of %zu selected, %llu bytes summed\n", selected.size(), all.size(), static_cast<unsigned long long>(bytes));
+        }
+
+        Registrar s_packetBatch("packet_batch", [] {
+            packetBatch();
+        });
+
+    }
+
+}
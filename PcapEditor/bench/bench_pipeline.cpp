@@ -0,0 +1,109 @@
+#include "bench.hpp"
+
+#include <concrete_nodes.hpp>
+#include <pipeline.hpp>
+
+#include <cstdio>
+#include <memory>
+#include <string>
+
+namespace PcapEditor::bench {
+
+    namespace {
+
+        constexpr u32 BatchCount = 16;
+
+        // Stands in for NodePcap, outputs the same stream every evaluation
+        class NodeStreamSource : public Node {
+        public:
+            explicit NodeStreamSource(PacketStream &stream)
+                : Node("bench.source", { Attribute(Attribute::IOType::Out, Attribute::Type::PacketStream, "Packets") }), m_stream(stream) { }
+
+            void process() override {
+                this->setTOnOutput<PacketStream>(0, &this->m_stream);
+            }
+
+        private:
+            PacketStream &m_stream;
+        };
+
+        PacketStream makeStream() {
+            const auto frames        = makePacketFrames(PacketBatch::MaxPackets);
+            const timespec timestamp = { 0, 0 };
+
+            PacketStream stream;
+            for (u32 i = 0; i < BatchCount; i++) {
+                auto batch = PacketBatchPool::getInstance().acquire();
+                for (const auto &frame : frames)
+                    batch->push(frame, u32(frame.size()), timestamp);
+
+                stream.addBatch(std::move(batch));
+            }
+
+            return stream;
+        }
+
+        // TCP -> port 443 -> length, repeated to get chains longer than a single fused pass
+        void operatorChain(PacketStream &stream, u32 repeats) {
+            std::vector<std::unique_ptr<Node>> nodes;
+            std::vector<std::pair<Attribute *, Attribute *>> connections;
+
+            nodes.push_back(std::make_unique<NodeStreamSource>(stream));
+            Attribute *previous = &nodes.back()->getAttributes()[0];
+
+            auto append = [&](std::unique_ptr<Node> node) {
+                connect(*previous, node->getAttributes()[0]);
+                connections.emplace_back(&node->getAttributes()[0], previous);
+
+                previous = &node->getAttributes()[1];
+                nodes.push_back(std::move(node));
+            };
+
+            for (u32 i = 0; i < repeats; i++) {
+                append(std::make_unique<NodePacketFilter>());
+                append(std::make_unique<NodePacketPortFilter>());
+
+                auto length = std::make_unique<NodePacketLengthFilter>();
+                nlohmann::json data = { { "min", 100 }, { "max", 1514 } };
+                length->load(data);
+                append(std::move(length));
+            }
+
+            std::vector<Node *> rawNodes;
+            for (auto &node : nodes)
+                rawNodes.push_back(node.get());
+
+            const auto label = std::to_string(repeats * 3) + " operator nodes, " + std::to_string(BatchCount) + "x1024 packets";
+
+            auto evaluate = [&] {
+                for (auto &node : nodes) {
+                    node->resetOutputData();
+                    node->resetProcessedInputs();
+                }
+
+                nodes.back()->process();
+            };
+
+            PacketOperatorNode::fuseChains(rawNodes, {});
+            measure(label + ", node at a time", 100, evaluate);
+
+            PacketOperatorNode::fuseChains(rawNodes, connections);
+            measure(label + ", fused", 100, evaluate);
+
+            size_t selected = 0;
+            for (const auto &selection : static_cast<PacketStream *>(previous->getOutputData().getPointer())->getSelections())
+                selected += selection.indices.size();
+
+            std::printf("  %zu packets selected\n", selected);
+        }
+
+        Registrar s_pipeline("pipeline", [] {
+            auto stream = makeStream();
+
+            operatorChain(stream, 1);
+            operatorChain(stream, 2);
+        });
+
+    }
+
+}
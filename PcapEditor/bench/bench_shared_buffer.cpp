@@ -0,0 +1,81 @@
+#include "bench.hpp"
+
+#include <concrete_nodes.hpp>
+
+#include <cstdio>
+#include <memory>
+
+namespace PcapEditor::bench {
+
+    namespace {
+
+        // 1 MiB buffer -> If -> NOT -> Slice -> If -> display
+        void bufferChain() {
+            std::vector<std::unique_ptr<Node>> nodes;
+
+            auto makeConstant = [&](u64 value) {
+                auto constant = std::make_unique<NodeInteger>();
+                nlohmann::json data = { { "data", value } };
+                constant->load(data);
+
+                return &nodes.emplace_back(std::move(constant))->getAttributes()[0];
+            };
+
+            auto source = std::make_unique<NodeBuffer>();
+            nlohmann::json data = { { "size", 1024 * 1024 }, { "data", std::vector<u8>(1024 * 1024, 0x55) } };
+            source->load(data);
+            Attribute *previous = &source->getAttributes()[0];
+            nodes.push_back(std::move(source));
+
+            auto condition = makeConstant(1);
+            auto addIf = [&] {
+                auto node = std::make_unique<NodeIf>();
+                connect(*condition, node->getAttributes()[0]);
+                connect(*previous, node->getAttributes()[1]);
+                connect(*previous, node->getAttributes()[2]);
+                previous = &node->getAttributes()[3];
+                nodes.push_back(std::move(node));
+            };
+
+            addIf();
+
+            auto bitwiseNot = std::make_unique<NodeBitwiseNOT>();
+            connect(*previous, bitwiseNot->getAttributes()[0]);
+            previous = &bitwiseNot->getAttributes()[1];
+            nodes.push_back(std::move(bitwiseNot));
+
+            auto slice = std::make_unique<NodeBufferSlice>();
+            connect(*previous, slice->getAttributes()[0]);
+            connect(*makeConstant(16), slice->getAttributes()[1]);
+            connect(*makeConstant(512 * 1024), slice->getAttributes()[2]);
+            previous = &slice->getAttributes()[3];
+            nodes.push_back(std::move(slice));
+
+            addIf();
+
+            auto display = std::make_unique<NodeDisplayBuffer>();
+            connect(*previous, display->getAttributes()[0]);
+            nodes.push_back(std::move(display));
+
+            const auto bytesCopied = SharedBuffer::getBytesCopied();
+            constexpr u32 Iterations = 100;
+
+            measure("1 MiB buffer through a 5 node chain", Iterations, [&] {
+                for (auto &node : nodes) {
+                    node->resetOutputData();
+                    node->resetProcessedInputs();
+                }
+
+                nodes.back()->process();
+            });
+
+            std::printf("  %-48s %14.1f bytes/iter\n", "bytes copied", double(SharedBuffer::getBytesCopied() - bytesCopied) / (Iterations + 1));
+        }
+
+        Registrar s_sharedBuffer("shared_buffer", [] {
+            bufferChain();
+        });
+
+    }
+
+}
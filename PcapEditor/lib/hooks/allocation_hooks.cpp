@@ -0,0 +1,44 @@
+#include <allocation_counter.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+// Replaces the global allocation functions to count every allocation, see allocation_counter.hpp. The array, nothrow
+// and sized forms fall back to these.
+
+void *operator new(std::size_t size) {
+    PcapEditor::allocation::impl::countAllocation(size);
+
+    if (auto pointer = std::malloc(size == 0 ? 1 : size))
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    PcapEditor::allocation::impl::countAllocation(size);
+
+    // aligned_alloc wants a non-zero multiple of the alignment
+    const auto align = static_cast<std::size_t>(alignment);
+    if (auto pointer = std::aligned_alloc(align, (std::max<std::size_t>(size, 1) + align - 1) / align * align))
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept {
+    std::free(pointer);
+}
@@ -60,6 +60,21 @@ public:
 			sslPacketCount++;
 	}
 
+	/**
+	 * Collect stats from the protocol bitmask the packet batch parser computed, no pcpp::Packet needed
+	 */
+	void consumeProtocols(pcpp::ProtocolType protocols)
+	{
+		ethPacketCount += (protocols & pcpp::Ethernet) != 0;
+		ipv4PacketCount += (protocols & pcpp::IPv4) != 0;
+		ipv6PacketCount += (protocols & pcpp::IPv6) != 0;
+		tcpPacketCount += (protocols & pcpp::TCP) != 0;
+		udpPacketCount += (protocols & pcpp::UDP) != 0;
+		dnsPacketCount += (protocols & pcpp::DNS) != 0;
+		httpPacketCount += (protocols & pcpp::HTTP) != 0;
+		sslPacketCount += (protocols & pcpp::SSL) != 0;
+	}
+
 	/**
 	 * Print stats to console
 	 */
@@ -0,0 +1,22 @@
+#pragma once
+#include <defination.hpp>
+
+#include <cstddef>
+
+namespace PcapEditor::allocation {
+
+    // Heap allocations made by the calling thread so far. Only counted in programs linking the allocation_hooks objects,
+    // which replace the global operator new (the bench, and the editor with PCAP_EDITOR_COUNT_ALLOCATIONS), 0 otherwise.
+    // Per-thread so measuring a node doesn't pick up allocations of nodes running next to it.
+    [[nodiscard]] u64 getThreadCount();
+    // Bytes requested by those allocations, frees aren't subtracted
+    [[nodiscard]] u64 getThreadBytes();
+
+    namespace impl {
+
+        // Called by the replaced operator new
+        void countAllocation(std::size_t size);
+
+    }
+
+}
@@ -1,10 +1,11 @@
 #pragma once
 #include <defination.hpp>
+#include <output_slot.hpp>
 
 #include <optional>
 #include <string>
 #include <string_view>
-#include <map>
+#include <utility>
 #include <vector>
 
 namespace PcapEditor {
@@ -20,7 +21,8 @@ namespace PcapEditor {
             // Filter,
             // Stat,
             String,
-            Pointer
+            Pointer,
+            PacketStream
         };
 
         enum class IOType {
@@ -38,28 +40,39 @@ namespace PcapEditor {
         [[nodiscard]] Type getType() const { return this->m_type; }
         [[nodiscard]] const std::string &getUnlocalizedName() const { return this->m_unlocalizedName; }
 
-        void addConnectedAttribute(u32 linkId, Attribute *to) { this->m_connectedAttributes.insert({ linkId, to }); }
-        void removeConnectedAttribute(u32 linkId) { this->m_connectedAttributes.erase(linkId); }
-        [[nodiscard]] std::map<u32, Attribute *> &getConnectedAttributes() { return this->m_connectedAttributes; }
+        // Link id and attribute at its other end. An attribute rarely has more than a handful, a flat list beats a tree.
+        using Connections = std::vector<std::pair<u32, Attribute *>>;
+
+        void addConnectedAttribute(u32 linkId, Attribute *to) { this->m_connectedAttributes.emplace_back(linkId, to); }
+        void removeConnectedAttribute(u32 linkId) {
+            std::erase_if(this->m_connectedAttributes, [linkId](const auto &connection) { return connection.first == linkId; });
+        }
+        [[nodiscard]] Connections &getConnectedAttributes() { return this->m_connectedAttributes; }
 
         [[nodiscard]] Node *getParentNode() { return this->m_parentNode; }
 
-        [[nodiscard]] std::optional<std::vector<u8>> &getOutputData() { return this->m_outputData; }
+        // Output feeding this input in the snapshot the evaluation thread works on, independent of edits in progress
+        [[nodiscard]] Attribute *getInputSource() const { return this->m_inputSource; }
+        void setInputSource(Attribute *source) { this->m_inputSource = source; }
+
+        [[nodiscard]] OutputSlot &getOutputData() { return this->m_outputData; }
 
         static void setIdCounter(u32 id) {
             if (id > Attribute::s_idCounter)
                 Attribute::s_idCounter = id;
         }
+        [[nodiscard]] static u32 getIdCounter() { return Attribute::s_idCounter; }
 
     private:
         u32 m_id;
         IOType m_ioType;
         Type m_type;
         std::string m_unlocalizedName;
-        std::map<u32, Attribute *> m_connectedAttributes;
+        Connections m_connectedAttributes;
         Node *m_parentNode = nullptr;
+        Attribute *m_inputSource = nullptr;
 
-        std::optional<std::vector<u8>> m_outputData;
+        OutputSlot m_outputData;
 
         friend class Node;
         void setParentNode(Node *node) { this->m_parentNode = node; }
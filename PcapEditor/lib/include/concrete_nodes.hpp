@@ -15,6 +15,12 @@
 #include <pcapplusplus/EthLayer.h>
 #include <pcapplusplus/PcapFilter.h>
 #include <PacketState.hpp>
+#include <packet_stream.hpp>
+#include <pipeline.hpp>
+
+#include <array>
+#include <ctime>
+#include <stdexcept>
 // #include "PcapFilter.h"
 // #include "PcapFileDevice.h"
 
@@ -26,6 +32,8 @@ namespace PcapEditor
     public:
         NodeNullptr() : Node("hex.builtin.nodes.constants.nullptr.header", { Attribute(Attribute::IOType::Out, Attribute::Type::Buffer, "") }) { }
 
+        [[nodiscard]] bool isConstant() const override { return true; }
+
         void process() override {
             this->setBufferOnOutput(0, {});
         }
@@ -39,13 +47,16 @@ namespace PcapEditor
             constexpr int StepSize = 1, FastStepSize = 10;
 
             ImGui::PushItemWidth(100);
-            ImGui::InputScalar("hex.builtin.nodes.constants.buffer.size", ImGuiDataType_U32, &this->m_size, &StepSize, &FastStepSize);
+            if (ImGui::InputScalar("hex.builtin.nodes.constants.buffer.size", ImGuiDataType_U32, &this->m_size, &StepSize, &FastStepSize))
+                this->markParametersChanged();
             ImGui::PopItemWidth();
         }
 
+        [[nodiscard]] bool isConstant() const override { return true; }
+
         void process() override {
             if (this->m_buffer.size() != this->m_size)
-                this->m_buffer.resize(this->m_size, 0x00);
+                this->m_buffer.mutate().resize(this->m_size, 0x00);
 
             this->setBufferOnOutput(0, this->m_buffer);
         }
@@ -54,17 +65,18 @@ namespace PcapEditor
             j = nlohmann::json::object();
 
             j["size"] = this->m_size;
-            j["data"] = this->m_buffer;
+            j["data"] = std::vector<u8>(this->m_buffer.begin(), this->m_buffer.end());
         }
 
         void load(nlohmann::json &j) override {
             this->m_size   = j["size"];
             this->m_buffer = j["data"].get<std::vector<u8>>();
+            this->markParametersChanged();
         }
 
     private:
         u32 m_size = 1;
-        std::vector<u8> m_buffer;
+        SharedBuffer m_buffer;
     };
 
     class NodeString : public Node {
@@ -75,17 +87,20 @@ namespace PcapEditor
 
         void drawNode() override {
             ImGui::PushItemWidth(100);
-            ImGui::InputText("##string", reinterpret_cast<char *>(this->m_value.data()), this->m_value.size() - 1);
+            if (ImGui::InputText("##string", reinterpret_cast<char *>(this->m_value.data()), this->m_value.size() - 1))
+                this->markParametersChanged();
             ImGui::PopItemWidth();
         }
 
+        [[nodiscard]] bool isConstant() const override { return true; }
+
         void process() override {
             std::vector<u8> output(std::strlen(this->m_value.c_str()) + 1, 0x00);
             std::strcpy(reinterpret_cast<char *>(output.data()), this->m_value.c_str());
 
             output.pop_back();
 
-            this->setBufferOnOutput(0, output);
+            this->setBufferOnOutput(0, std::move(output));
         }
 
         void store(nlohmann::json &j) override {
@@ -96,6 +111,7 @@ namespace PcapEditor
 
         void load(nlohmann::json &j) override {
             this->m_value = j["data"];
+            this->markParametersChanged();
         }
 
     private:
@@ -109,10 +125,13 @@ namespace PcapEditor
 
         void drawNode() override {
             ImGui::PushItemWidth(100);
-            ImGui::InputHexadecimal("##integer_value", &this->m_value);
+            if (ImGui::InputHexadecimal("##integer_value", &this->m_value))
+                this->markParametersChanged();
             ImGui::PopItemWidth();
         }
 
+        [[nodiscard]] bool isConstant() const override { return true; }
+
         void process() override {
             this->setIntegerOnOutput(0, this->m_value);
         }
@@ -125,6 +144,7 @@ namespace PcapEditor
 
         void load(nlohmann::json &j) override {
             this->m_value = j["data"];
+            this->markParametersChanged();
         }
 
     private:
@@ -137,10 +157,13 @@ namespace PcapEditor
 
         void drawNode() override {
             ImGui::PushItemWidth(100);
-            ImGui::InputScalar("##floatValue", ImGuiDataType_Float, &this->m_value, nullptr, nullptr, "%f", ImGuiInputTextFlags_CharsDecimal);
+            if (ImGui::InputScalar("##floatValue", ImGuiDataType_Float, &this->m_value, nullptr, nullptr, "%f", ImGuiInputTextFlags_CharsDecimal))
+                this->markParametersChanged();
             ImGui::PopItemWidth();
         }
 
+        [[nodiscard]] bool isConstant() const override { return true; }
+
         void process() override {
             this->setFloatOnOutput(0, this->m_value);
         }
@@ -153,6 +176,7 @@ namespace PcapEditor
 
         void load(nlohmann::json &j) override {
             this->m_value = j["data"];
+            this->markParametersChanged();
         }
 
     private:
@@ -169,15 +193,18 @@ namespace PcapEditor
 
         void drawNode() override {
             ImGui::PushItemWidth(200);
-            ImGui::ColorPicker4("##colorPicker", &this->m_color.Value.x, ImGuiColorEditFlags_AlphaBar);
+            if (ImGui::ColorPicker4("##colorPicker", &this->m_color.Value.x, ImGuiColorEditFlags_AlphaBar))
+                this->markParametersChanged();
             ImGui::PopItemWidth();
         }
 
+        [[nodiscard]] bool isConstant() const override { return true; }
+
         void process() override {
-            this->setBufferOnOutput(0, utility::toBytes<u64>(this->m_color.Value.x * 0xFF));
-            this->setBufferOnOutput(1, utility::toBytes<u64>(this->m_color.Value.y * 0xFF));
-            this->setBufferOnOutput(2, utility::toBytes<u64>(this->m_color.Value.z * 0xFF));
-            this->setBufferOnOutput(3, utility::toBytes<u64>(this->m_color.Value.w * 0xFF));
+            this->setIntegerOnOutput(0, this->m_color.Value.x * 0xFF);
+            this->setIntegerOnOutput(1, this->m_color.Value.y * 0xFF);
+            this->setIntegerOnOutput(2, this->m_color.Value.z * 0xFF);
+            this->setIntegerOnOutput(3, this->m_color.Value.w * 0xFF);
         }
 
         void store(nlohmann::json &j) override {
@@ -192,6 +219,7 @@ namespace PcapEditor
 
         void load(nlohmann::json &j) override {
             this->m_color = ImVec4(j["data"]["r"], j["data"]["g"], j["data"]["b"], j["data"]["a"]);
+            this->markParametersChanged();
         }
 
     private:
@@ -258,7 +286,7 @@ namespace PcapEditor
             ImGui::PushItemWidth(150);
             if (this->m_value.has_value())
             {
-                auto v = this->m_value.value() ;
+                auto &v = this->m_value.value() ;
                 
                 ImGui::TextFormatted("{0}", utility::hexStr(v.data(), v.size()));
             }
@@ -276,7 +304,7 @@ namespace PcapEditor
         }
 
     private:
-        std::optional<std::vector<u8> > m_value;
+        std::optional<SharedBuffer> m_value;
     };
     class NodeDisplayString : public Node {
     public:
@@ -335,14 +363,15 @@ namespace PcapEditor
     public:
         NodeBitwiseNOT() : Node("hex.builtin.nodes.bitwise.not.header", { Attribute(Attribute::IOType::In, Attribute::Type::Buffer, "hex.builtin.nodes.common.input"), Attribute(Attribute::IOType::Out, Attribute::Type::Buffer, "hex.builtin.nodes.common.output") }) { }
 
+        [[nodiscard]] bool isPure() const override { return true; }
+
         void process() override {
-            auto input = this->getBufferOnInput(0);
+            auto output = this->getBufferOnInput(0);
 
-            std::vector<u8> output = input;
-            for (auto &byte : output)
+            for (auto &byte : output.mutate())
                 byte = ~byte;
 
-            this->setBufferOnOutput(1, output);
+            this->setBufferOnOutput(1, std::move(output));
         }
     };
 
@@ -350,6 +379,8 @@ namespace PcapEditor
     public:
         NodeBitwiseAND() : Node("hex.builtin.nodes.bitwise.and.header", { Attribute(Attribute::IOType::In, Attribute::Type::Buffer, "hex.builtin.nodes.common.input.a"), Attribute(Attribute::IOType::In, Attribute::Type::Buffer, "hex.builtin.nodes.common.input.b"), Attribute(Attribute::IOType::Out, Attribute::Type::Buffer, "hex.builtin.nodes.common.output") }) { }
 
+        [[nodiscard]] bool isPure() const override { return true; }
+
         void process() override {
             auto inputA = this->getBufferOnInput(0);
             auto inputB = this->getBufferOnInput(1);
@@ -359,7 +390,7 @@ namespace PcapEditor
             for (u32 i = 0; i < output.size(); i++)
                 output[i] = inputA[i] & inputB[i];
 
-            this->setBufferOnOutput(2, output);
+            this->setBufferOnOutput(2, std::move(output));
         }
     };
 
@@ -367,6 +398,8 @@ namespace PcapEditor
     public:
         NodeBitwiseOR() : Node("hex.builtin.nodes.bitwise.or.header", { Attribute(Attribute::IOType::In, Attribute::Type::Buffer, "hex.builtin.nodes.common.input.a"), Attribute(Attribute::IOType::In, Attribute::Type::Buffer, "hex.builtin.nodes.common.input.b"), Attribute(Attribute::IOType::Out, Attribute::Type::Buffer, "hex.builtin.nodes.common.output") }) { }
 
+        [[nodiscard]] bool isPure() const override { return true; }
+
         void process() override {
             auto inputA = this->getBufferOnInput(0);
             auto inputB = this->getBufferOnInput(1);
@@ -376,7 +409,7 @@ namespace PcapEditor
             for (u32 i = 0; i < output.size(); i++)
                 output[i] = inputA[i] | inputB[i];
 
-            this->setBufferOnOutput(2, output);
+            this->setBufferOnOutput(2, std::move(output));
         }
     };
 
@@ -384,6 +417,8 @@ namespace PcapEditor
     public:
         NodeBitwiseXOR() : Node("hex.builtin.nodes.bitwise.xor.header", { Attribute(Attribute::IOType::In, Attribute::Type::Buffer, "hex.builtin.nodes.common.input.a"), Attribute(Attribute::IOType::In, Attribute::Type::Buffer, "hex.builtin.nodes.common.input.b"), Attribute(Attribute::IOType::Out, Attribute::Type::Buffer, "hex.builtin.nodes.common.output") }) { }
 
+        [[nodiscard]] bool isPure() const override { return true; }
+
         void process() override {
             auto inputA = this->getBufferOnInput(0);
             auto inputB = this->getBufferOnInput(1);
@@ -393,7 +428,7 @@ namespace PcapEditor
             for (u32 i = 0; i < output.size(); i++)
                 output[i] = inputA[i] ^ inputB[i];
 
-            this->setBufferOnOutput(2, output);
+            this->setBufferOnOutput(2, std::move(output));
         }
     };
 
@@ -416,13 +451,15 @@ namespace PcapEditor
     public:
         NodeCastIntegerToBuffer() : Node("hex.builtin.nodes.casting.int_to_buffer.header", { Attribute(Attribute::IOType::In, Attribute::Type::Integer, "hex.builtin.nodes.common.input"), Attribute(Attribute::IOType::Out, Attribute::Type::Buffer, "hex.builtin.nodes.common.output") }) { }
 
+        [[nodiscard]] bool isPure() const override { return true; }
+
         void process() override {
             auto input = this->getIntegerOnInput(0);
 
             std::vector<u8> output(sizeof(u64), 0x00);
             std::memcpy(output.data(), &input, sizeof(u64));
 
-            this->setBufferOnOutput(1, output);
+            this->setBufferOnOutput(1, std::move(output));
         }
     };
 
@@ -430,6 +467,8 @@ namespace PcapEditor
     public:
         NodeCastBufferToInteger() : Node("hex.builtin.nodes.casting.buffer_to_int.header", { Attribute(Attribute::IOType::In, Attribute::Type::Buffer, "hex.builtin.nodes.common.input"), Attribute(Attribute::IOType::Out, Attribute::Type::Integer, "hex.builtin.nodes.common.output") }) { }
 
+        [[nodiscard]] bool isPure() const override { return true; }
+
         void process() override {
             auto input = this->getBufferOnInput(0);
 
@@ -447,6 +486,8 @@ namespace PcapEditor
     public:
         NodeArithmeticAdd() : Node("hex.builtin.nodes.arithmetic.add.header", { Attribute(Attribute::IOType::In, Attribute::Type::Integer, "hex.builtin.nodes.common.input.a"), Attribute(Attribute::IOType::In, Attribute::Type::Integer, "hex.builtin.nodes.common.input.b"), Attribute(Attribute::IOType::Out, Attribute::Type::Integer, "hex.builtin.nodes.common.output") }) { }
 
+        [[nodiscard]] bool isPure() const override { return true; }
+
         void process() override {
             auto inputA = this->getIntegerOnInput(0);
             auto inputB = this->getIntegerOnInput(1);
@@ -461,6 +502,8 @@ namespace PcapEditor
     public:
         NodeArithmeticSubtract() : Node("hex.builtin.nodes.arithmetic.sub.header", { Attribute(Attribute::IOType::In, Attribute::Type::Integer, "hex.builtin.nodes.common.input.a"), Attribute(Attribute::IOType::In, Attribute::Type::Integer, "hex.builtin.nodes.common.input.b"), Attribute(Attribute::IOType::Out, Attribute::Type::Integer, "hex.builtin.nodes.common.output") }) { }
 
+        [[nodiscard]] bool isPure() const override { return true; }
+
         void process() override {
             auto inputA = this->getIntegerOnInput(0);
             auto inputB = this->getIntegerOnInput(1);
@@ -475,6 +518,8 @@ namespace PcapEditor
     public:
         NodeArithmeticMultiply() : Node("hex.builtin.nodes.arithmetic.mul.header", { Attribute(Attribute::IOType::In, Attribute::Type::Integer, "hex.builtin.nodes.common.input.a"), Attribute(Attribute::IOType::In, Attribute::Type::Integer, "hex.builtin.nodes.common.input.b"), Attribute(Attribute::IOType::Out, Attribute::Type::Integer, "hex.builtin.nodes.common.output") }) { }
 
+        [[nodiscard]] bool isPure() const override { return true; }
+
         void process() override {
             auto inputA = this->getIntegerOnInput(0);
             auto inputB = this->getIntegerOnInput(1);
@@ -489,6 +534,8 @@ namespace PcapEditor
     public:
         NodeArithmeticDivide() : Node("hex.builtin.nodes.arithmetic.div.header", { Attribute(Attribute::IOType::In, Attribute::Type::Integer, "hex.builtin.nodes.common.input.a"), Attribute(Attribute::IOType::In, Attribute::Type::Integer, "hex.builtin.nodes.common.input.b"), Attribute(Attribute::IOType::Out, Attribute::Type::Integer, "hex.builtin.nodes.common.output") }) { }
 
+        [[nodiscard]] bool isPure() const override { return true; }
+
         void process() override {
             auto inputA = this->getIntegerOnInput(0);
             auto inputB = this->getIntegerOnInput(1);
@@ -506,6 +553,8 @@ namespace PcapEditor
     public:
         NodeArithmeticModulus() : Node("hex.builtin.nodes.arithmetic.mod.header", { Attribute(Attribute::IOType::In, Attribute::Type::Integer, "hex.builtin.nodes.common.input.a"), Attribute(Attribute::IOType::In, Attribute::Type::Integer, "hex.builtin.nodes.common.input.b"), Attribute(Attribute::IOType::Out, Attribute::Type::Integer, "hex.builtin.nodes.common.output") }) { }
 
+        [[nodiscard]] bool isPure() const override { return true; }
+
         void process() override {
             auto inputA = this->getIntegerOnInput(0);
             auto inputB = this->getIntegerOnInput(1);
@@ -523,14 +572,18 @@ namespace PcapEditor
     public:
         NodeBufferCombine() : Node("hex.builtin.nodes.buffer.combine.header", { Attribute(Attribute::IOType::In, Attribute::Type::Buffer, "hex.builtin.nodes.common.input.a"), Attribute(Attribute::IOType::In, Attribute::Type::Buffer, "hex.builtin.nodes.common.input.b"), Attribute(Attribute::IOType::Out, Attribute::Type::Buffer, "hex.builtin.nodes.common.output") }) { }
 
+        [[nodiscard]] bool isPure() const override { return true; }
+
         void process() override {
             auto inputA = this->getBufferOnInput(0);
             auto inputB = this->getBufferOnInput(1);
 
-            auto &output = inputA;
-            std::copy(inputB.begin(), inputB.end(), std::back_inserter(output));
+            std::vector<u8> output;
+            output.reserve(inputA.size() + inputB.size());
+            output.insert(output.end(), inputA.begin(), inputA.end());
+            output.insert(output.end(), inputB.begin(), inputB.end());
 
-            this->setBufferOnOutput(2, output);
+            this->setBufferOnOutput(2, std::move(output));
         }
     };
 
@@ -538,6 +591,8 @@ namespace PcapEditor
     public:
         NodeBufferSlice() : Node("hex.builtin.nodes.buffer.slice.header", { Attribute(Attribute::IOType::In, Attribute::Type::Buffer, "hex.builtin.nodes.buffer.slice.input.buffer"), Attribute(Attribute::IOType::In, Attribute::Type::Integer, "hex.builtin.nodes.buffer.slice.input.from"), Attribute(Attribute::IOType::In, Attribute::Type::Integer, "hex.builtin.nodes.buffer.slice.input.to"), Attribute(Attribute::IOType::Out, Attribute::Type::Buffer, "hex.builtin.nodes.common.output") }) { }
 
+        [[nodiscard]] bool isPure() const override { return true; }
+
         void process() override {
             auto input = this->getBufferOnInput(0);
             auto from  = this->getIntegerOnInput(1);
@@ -545,12 +600,12 @@ namespace PcapEditor
 
             if (from < 0 || from >= input.size())
                 throwNodeError("'from' input out of range");
-            if (to < 0 || from >= input.size())
+            if (to < 0 || to > input.size())
                 throwNodeError("'to' input out of range");
             if (to <= from)
                 throwNodeError("'to' input needs to be greater than 'from' input");
 
-            this->setBufferOnOutput(3, std::vector(input.begin() + from, input.begin() + to));
+            this->setBufferOnOutput(3, input.slice(from, to));
         }
     };
 
@@ -558,6 +613,8 @@ namespace PcapEditor
     public:
         NodeBufferRepeat() : Node("hex.builtin.nodes.buffer.repeat.header", { Attribute(Attribute::IOType::In, Attribute::Type::Buffer, "hex.builtin.nodes.buffer.repeat.input.buffer"), Attribute(Attribute::IOType::In, Attribute::Type::Integer, "hex.builtin.nodes.buffer.repeat.input.count"), Attribute(Attribute::IOType::Out, Attribute::Type::Buffer, "hex.builtin.nodes.common.output") }) { }
 
+        [[nodiscard]] bool isPure() const override { return true; }
+
         void process() override {
             auto buffer = this->getBufferOnInput(0);
             auto count  = this->getIntegerOnInput(1);
@@ -568,7 +625,7 @@ namespace PcapEditor
             for (u32 i = 0; i < count; i++)
                 std::copy(buffer.begin(), buffer.end(), output.begin() + buffer.size() * i);
 
-            this->setBufferOnOutput(2, output);
+            this->setBufferOnOutput(2, std::move(output));
         }
     };
 
@@ -580,15 +637,17 @@ namespace PcapEditor
                            Attribute(Attribute::IOType::In, Attribute::Type::Buffer, "hex.builtin.nodes.control_flow.if.false"),
                            Attribute(Attribute::IOType::Out, Attribute::Type::Buffer, "hex.builtin.nodes.common.output") }) { }
 
+        [[nodiscard]] bool isPure() const override { return true; }
+
         void process() override {
             auto cond      = this->getIntegerOnInput(0);
             auto trueData  = this->getBufferOnInput(1);
             auto falseData = this->getBufferOnInput(2);
 
             if (cond != 0)
-                this->setBufferOnOutput(3, trueData);
+                this->setBufferOnOutput(3, std::move(trueData));
             else
-                this->setBufferOnOutput(3, falseData);
+                this->setBufferOnOutput(3, std::move(falseData));
         }
     };
 
@@ -599,6 +658,8 @@ namespace PcapEditor
                                Attribute(Attribute::IOType::In, Attribute::Type::Integer, "hex.builtin.nodes.common.input.b"),
                                Attribute(Attribute::IOType::Out, Attribute::Type::Integer, "hex.builtin.nodes.common.output") }) { }
 
+        [[nodiscard]] bool isPure() const override { return true; }
+
         void process() override {
             auto inputA = this->getIntegerOnInput(0);
             auto inputB = this->getIntegerOnInput(1);
@@ -613,6 +674,8 @@ namespace PcapEditor
                         { Attribute(Attribute::IOType::In, Attribute::Type::Integer, "hex.builtin.nodes.common.input"),
                             Attribute(Attribute::IOType::Out, Attribute::Type::Integer, "hex.builtin.nodes.common.output") }) { }
 
+        [[nodiscard]] bool isPure() const override { return true; }
+
         void process() override {
             auto input = this->getIntegerOnInput(0);
 
@@ -627,6 +690,8 @@ namespace PcapEditor
                                     Attribute(Attribute::IOType::In, Attribute::Type::Integer, "hex.builtin.nodes.common.input.b"),
                                     Attribute(Attribute::IOType::Out, Attribute::Type::Integer, "hex.builtin.nodes.common.output") }) { }
 
+        [[nodiscard]] bool isPure() const override { return true; }
+
         void process() override {
             auto inputA = this->getIntegerOnInput(0);
             auto inputB = this->getIntegerOnInput(1);
@@ -642,6 +707,8 @@ namespace PcapEditor
                                  Attribute(Attribute::IOType::In, Attribute::Type::Integer, "hex.builtin.nodes.common.input.b"),
                                  Attribute(Attribute::IOType::Out, Attribute::Type::Integer, "hex.builtin.nodes.common.output") }) { }
 
+        [[nodiscard]] bool isPure() const override { return true; }
+
         void process() override {
             auto inputA = this->getIntegerOnInput(0);
             auto inputB = this->getIntegerOnInput(1);
@@ -657,6 +724,8 @@ namespace PcapEditor
                                 Attribute(Attribute::IOType::In, Attribute::Type::Integer, "hex.builtin.nodes.common.input.b"),
                                 Attribute(Attribute::IOType::Out, Attribute::Type::Integer, "hex.builtin.nodes.common.output") }) { }
 
+        [[nodiscard]] bool isPure() const override { return true; }
+
         void process() override {
             auto inputA = this->getIntegerOnInput(0);
             auto inputB = this->getIntegerOnInput(1);
@@ -672,6 +741,8 @@ namespace PcapEditor
                                Attribute(Attribute::IOType::In, Attribute::Type::Integer, "hex.builtin.nodes.common.input.b"),
                                Attribute(Attribute::IOType::Out, Attribute::Type::Integer, "hex.builtin.nodes.common.output") }) { }
 
+        [[nodiscard]] bool isPure() const override { return true; }
+
         void process() override {
             auto inputA = this->getIntegerOnInput(0);
             auto inputB = this->getIntegerOnInput(1);
@@ -724,10 +795,12 @@ namespace PcapEditor
                                     
                                 }
 
+        bool isThreadSafe() const override { return false; }
+
         void drawNode() override {
 
             ImGui::Text(output.c_str());
-            
+            ImGui::TextFormatted("sampled every {0:.1f} ms", this->m_sampleInterval * 1000);
             
         }
 
@@ -736,12 +809,13 @@ namespace PcapEditor
             // p_stats= this->getStatsOnInput(0);
             p_stats= this->getTOnInput<pcpp::Stats, Attribute::Type::Pointer>(0);
             output = p_stats->printToConsole();
-            
+            this->m_sampleInterval = getTickInterval();
             
         }
     private:
         pcpp::Stats* p_stats;
         std::string output;
+        double m_sampleInterval = 0;
         
     };
 
@@ -798,7 +872,8 @@ namespace PcapEditor
             {
                 Attribute(Attribute::IOType::Out, Attribute::Type::String, "Interface Info"),
                 Attribute(Attribute::IOType::Out, Attribute::Type::Pointer, "Packet Statistic struct") ,
-                Attribute(Attribute::IOType::In, Attribute::Type::Pointer, "filter") }) { 
+                Attribute(Attribute::IOType::In, Attribute::Type::Pointer, "filter"),
+                Attribute(Attribute::IOType::Out, Attribute::Type::PacketStream, "Packets") }) { 
             this->m_deviceList = pcpp::PcapLiveDeviceList::getInstance().getPcapLiveDevicesList();
             open(item_current_idx, item_current_idx);
         }
@@ -811,6 +886,8 @@ namespace PcapEditor
             closeall();
             
         }
+
+        bool isThreadSafe() const override { return false; }
         struct if_info{
             std::string name;
             std::string desc;
@@ -859,6 +936,7 @@ namespace PcapEditor
                 }
                 std::string output = utility::format("cur if:{0}", (m_deviceList[item_current_idx]->getName()));
                 ImGui::Text(output.c_str());
+                ImGui::TextFormatted("dropped: {0}", this->m_capture.getDroppedPackets());
                 
             }
 
@@ -885,7 +963,8 @@ namespace PcapEditor
                 item_current_idx = i;
                 select_dev = m_deviceList[item_current_idx];
                 select_dev->open();
-                select_dev->startCapture(onPacketArrives, &stats);
+                this->m_capture.clear();
+                select_dev->startCapture(onPacketArrives, this);
                 stats.clear();
             }
             catch(const std::exception& e)
@@ -897,16 +976,25 @@ namespace PcapEditor
         }
         static void onPacketArrives(pcpp::RawPacket* packet, pcpp::PcapLiveDevice* dev, void* cookie)
         {
-            // extract the stats object form the cookie
-            pcpp::PacketStats* stats = (pcpp::PacketStats*)cookie;
-
-            // parsed the raw packet
-            pcpp::Packet parsedPacket(packet);
-            // collect stats from packet
-            stats->consumePacket(parsedPacket);
+            auto node = static_cast<NodePcap *>(cookie);
+
+            // copy and parse the packet into the batch the graph will drain, collect stats from the parsed headers
+            if (auto protocols = node->m_capture.push(*packet)) {
+                node->stats.consumeProtocols(*protocols);
+            } else {
+                pcpp::Packet parsedPacket(packet);
+                node->stats.consumePacket(parsedPacket);
+            }
         }
 
         void process() override {
+            // hand everything captured since the last evaluation to the stream nodes
+            this->m_stream.clear();
+            this->m_capture.drain(this->m_batches);
+            for (auto &batch : this->m_batches)
+                this->m_stream.addBatch(std::move(batch));
+            this->m_batches.clear();
+            this->setTOnOutput<PacketStream>(3, &this->m_stream);
 
             // this->setStringOnOutput(0, if_information.get_if_info(select_dev)); 
             // this->setStatsOnOutput(1, &stats);
@@ -955,59 +1043,258 @@ namespace PcapEditor
         pcpp::GeneralFilter *filter;
         if_info if_information;
         std::string result;
+        PacketCapture m_capture;
+        std::vector<std::shared_ptr<PacketBatch>> m_batches;
+        PacketStream m_stream;
     };
-    
-void registerNodes() {
-        utility::add<NodeInteger>("hex.builtin.nodes.constants", "hex.builtin.nodes.constants.int");
-        utility::add<NodeFloat>("hex.builtin.nodes.constants", "hex.builtin.nodes.constants.float");
-        utility::add<NodeNullptr>("hex.builtin.nodes.constants", "hex.builtin.nodes.constants.nullptr");
-        utility::add<NodeBuffer>("hex.builtin.nodes.constants", "hex.builtin.nodes.constants.buffer");
-        utility::add<NodeString>("hex.builtin.nodes.constants", "hex.builtin.nodes.constants.string");
-        utility::add<NodeRGBA8>("hex.builtin.nodes.constants", "hex.builtin.nodes.constants.rgba8");
-        utility::add<NodeComment>("hex.builtin.nodes.constants", "hex.builtin.nodes.constants.comment");
-        
 
-        utility::add<NodeDisPlayStats>("hex.builtin.nodes.display", "hex.builtin.nodes.display.stats");
+    inline const std::array<std::pair<const char *, pcpp::ProtocolType>, 10> StreamProtocols = { {
+        { "Ethernet", pcpp::Ethernet },
+        { "IPv4", pcpp::IPv4 },
+        { "IPv6", pcpp::IPv6 },
+        { "TCP", pcpp::TCP },
+        { "UDP", pcpp::UDP },
+        { "ICMP", pcpp::ICMP },
+        { "ARP", pcpp::ARP },
+        { "DNS", pcpp::DNS },
+        { "HTTP", pcpp::HTTP },
+        { "SSL", pcpp::SSL },
+    } };
+
+    class NodePacketFilter : public PacketOperatorNode {
+    public:
+        NodePacketFilter() : PacketOperatorNode("hex.builtin.nodes.stream.filter.header") { }
 
-        utility::add<NodeDisplayInteger>("hex.builtin.nodes.display", "hex.builtin.nodes.display.int");
-        utility::add<NodeDisplayFloat>("hex.builtin.nodes.display", "hex.builtin.nodes.display.float");
-        utility::add<NodeDisplayBuffer>("hex.builtin.nodes.display", "hex.builtin.nodes.display.buffer");
-        utility::add<NodeDisplayString>("hex.builtin.nodes.display", "hex.builtin.nodes.display.string");
+        void drawNode() override {
+            ImGui::PushItemWidth(100);
+            ImGui::Combo(
+                "##protocol", &this->m_protocol, [](void *, int index, const char **name) {
+                    *name = StreamProtocols[index].first;
+                    return true;
+                },
+                nullptr, StreamProtocols.size());
+            ImGui::PopItemWidth();
+        }
+
+        [[nodiscard]] PacketOperator getOperator() const override {
+            return ProtocolOperator { StreamProtocols[this->m_protocol].second };
+        }
 
+        void store(nlohmann::json &j) override {
+            j = nlohmann::json::object();
 
-        utility::add<NodeCastIntegerToBuffer>("hex.builtin.nodes.casting", "hex.builtin.nodes.casting.int_to_buffer");
-        utility::add<NodeCastBufferToInteger>("hex.builtin.nodes.casting", "hex.builtin.nodes.casting.buffer_to_int");
+            j["protocol"] = this->m_protocol;
+        }
 
-        utility::add<NodeArithmeticAdd>("hex.builtin.nodes.arithmetic", "hex.builtin.nodes.arithmetic.add");
-        utility::add<NodeArithmeticSubtract>("hex.builtin.nodes.arithmetic", "hex.builtin.nodes.arithmetic.sub");
-        utility::add<NodeArithmeticMultiply>("hex.builtin.nodes.arithmetic", "hex.builtin.nodes.arithmetic.mul");
-        utility::add<NodeArithmeticDivide>("hex.builtin.nodes.arithmetic", "hex.builtin.nodes.arithmetic.div");
-        utility::add<NodeArithmeticModulus>("hex.builtin.nodes.arithmetic", "hex.builtin.nodes.arithmetic.mod");
+        void load(nlohmann::json &j) override {
+            const int protocol = j["protocol"];
+            if (protocol < 0 || protocol >= int(StreamProtocols.size()))
+                throw std::runtime_error(utility::format("Unknown stream protocol {0}", protocol));
 
-        utility::add<NodeBufferCombine>("hex.builtin.nodes.buffer", "hex.builtin.nodes.buffer.combine");
-        utility::add<NodeBufferSlice>("hex.builtin.nodes.buffer", "hex.builtin.nodes.buffer.slice");
-        utility::add<NodeBufferRepeat>("hex.builtin.nodes.buffer", "hex.builtin.nodes.buffer.repeat");
+            this->m_protocol = protocol;
+        }
 
-        utility::add<NodeIf>("hex.builtin.nodes.control_flow", "hex.builtin.nodes.control_flow.if");
-        utility::add<NodeEquals>("hex.builtin.nodes.control_flow", "hex.builtin.nodes.control_flow.equals");
-        utility::add<NodeNot>("hex.builtin.nodes.control_flow", "hex.builtin.nodes.control_flow.not");
-        utility::add<NodeGreaterThan>("hex.builtin.nodes.control_flow", "hex.builtin.nodes.control_flow.gt");
-        utility::add<NodeLessThan>("hex.builtin.nodes.control_flow", "hex.builtin.nodes.control_flow.lt");
-        utility::add<NodeBoolAND>("hex.builtin.nodes.control_flow", "hex.builtin.nodes.control_flow.and");
-        utility::add<NodeBoolOR>("hex.builtin.nodes.control_flow", "hex.builtin.nodes.control_flow.or");
+    private:
+        int m_protocol = 3;
+    };
 
-        utility::add<NodeBitwiseAND>("hex.builtin.nodes.bitwise", "hex.builtin.nodes.bitwise.and");
-        utility::add<NodeBitwiseOR>("hex.builtin.nodes.bitwise", "hex.builtin.nodes.bitwise.or");
-        utility::add<NodeBitwiseXOR>("hex.builtin.nodes.bitwise", "hex.builtin.nodes.bitwise.xor");
-        utility::add<NodeBitwiseNOT>("hex.builtin.nodes.bitwise", "hex.builtin.nodes.bitwise.not");
+    class NodePacketPortFilter : public PacketOperatorNode {
+    public:
+        NodePacketPortFilter() : PacketOperatorNode("hex.builtin.nodes.stream.port.header") { }
 
-        utility::add<NodeFilterOR>("hex.builtin.nodes.filter", "hex.builtin.nodes.filter.or");
-        
-        utility::add<NodePortFilter>("hex.builtin.nodes.filter", "hex.builtin.nodes.filter.portfilter");
-        utility::add<NodePcap>("hex.builtin.nodes.device", "hex.builtin.nodes.device.pcap");
+        void drawNode() override {
+            ImGui::PushItemWidth(100);
+            ImGui::InputInt("port", &this->m_port);
+            ImGui::PopItemWidth();
+            this->m_port = std::clamp(this->m_port, 0, 0xFFFF);
+        }
+
+        [[nodiscard]] PacketOperator getOperator() const override {
+            return PortOperator { u16(this->m_port) };
+        }
+
+        void store(nlohmann::json &j) override {
+            j = nlohmann::json::object();
 
+            j["port"] = this->m_port;
+        }
+
+        void load(nlohmann::json &j) override {
+            this->m_port = j["port"];
+        }
+
+    private:
+        int m_port = 443;
+    };
+
+    class NodePacketLengthFilter : public PacketOperatorNode {
+    public:
+        NodePacketLengthFilter() : PacketOperatorNode("hex.builtin.nodes.stream.length.header") { }
 
-    }      
+        void drawNode() override {
+            ImGui::PushItemWidth(100);
+            ImGui::InputInt("min", &this->m_min);
+            ImGui::InputInt("max", &this->m_max);
+            ImGui::PopItemWidth();
+            this->m_min = std::max(this->m_min, 0);
+            this->m_max = std::max(this->m_max, this->m_min);
+        }
+
+        [[nodiscard]] PacketOperator getOperator() const override {
+            return LengthOperator { u32(this->m_min), u32(this->m_max) };
+        }
+
+        void store(nlohmann::json &j) override {
+            j = nlohmann::json::object();
+
+            j["min"] = this->m_min;
+            j["max"] = this->m_max;
+        }
+
+        void load(nlohmann::json &j) override {
+            this->m_min = j["min"];
+            this->m_max = j["max"];
+        }
+
+    private:
+        int m_min = 0, m_max = 1514;
+    };
+
+    class NodePacketClassify : public Node {
+    public:
+        NodePacketClassify() : Node("hex.builtin.nodes.stream.classify.header",
+                                   { Attribute(Attribute::IOType::In, Attribute::Type::PacketStream, "hex.builtin.nodes.common.input"),
+                                     Attribute(Attribute::IOType::Out, Attribute::Type::PacketStream, "TCP"),
+                                     Attribute(Attribute::IOType::Out, Attribute::Type::PacketStream, "UDP"),
+                                     Attribute(Attribute::IOType::Out, Attribute::Type::PacketStream, "ICMP"),
+                                     Attribute(Attribute::IOType::Out, Attribute::Type::PacketStream, "Other") }) { }
+
+        void process() override {
+            auto input = this->getTOnInput<PacketStream, Attribute::Type::PacketStream>(0);
+
+            for (auto &stream : this->m_streams)
+                stream.clear();
+
+            for (const auto &selection : input->getSelections()) {
+                std::array<std::vector<u32> *, 4> indices;
+                for (u32 i = 0; i < indices.size(); i++)
+                    indices[i] = &this->m_streams[i].addSelection(selection.batch);
+
+                const auto protocols = selection.batch->getProtocols();
+                for (auto index : selection.indices) {
+                    if (protocols[index] & pcpp::TCP)
+                        indices[0]->push_back(index);
+                    else if (protocols[index] & pcpp::UDP)
+                        indices[1]->push_back(index);
+                    else if (protocols[index] & pcpp::ICMP)
+                        indices[2]->push_back(index);
+                    else
+                        indices[3]->push_back(index);
+                }
+            }
+
+            for (u32 i = 0; i < this->m_streams.size(); i++)
+                this->setTOnOutput<PacketStream>(i + 1, &this->m_streams[i]);
+        }
+
+    private:
+        std::array<PacketStream, 4> m_streams;
+    };
+
+    class NodePacketCount : public Node {
+    public:
+        NodePacketCount() : Node("hex.builtin.nodes.stream.count.header",
+                                { Attribute(Attribute::IOType::In, Attribute::Type::PacketStream, "hex.builtin.nodes.common.input"),
+                                  Attribute(Attribute::IOType::Out, Attribute::Type::Integer, "Packets"),
+                                  Attribute(Attribute::IOType::Out, Attribute::Type::Integer, "Bytes") }) { }
+
+        void drawNode() override {
+            ImGui::TextFormatted("{0} packets, {1} bytes", this->m_packets, this->m_bytes);
+            ImGui::TextFormatted("{0:.1f} packets/s", this->m_packetRate);
+            if (ImGui::Button("Reset"))
+                this->m_packets = this->m_bytes = 0;
+        }
+
+        void process() override {
+            auto input = this->getTOnInput<PacketStream, Attribute::Type::PacketStream>(0);
+
+            u64 packets = 0;
+            for (const auto &selection : input->getSelections()) {
+                packets += selection.indices.size();
+                this->m_bytes += kernels::sumWireLengths(*selection.batch, selection.indices);
+            }
+
+            this->m_packets += packets;
+            this->m_packetRate = getTickInterval() > 0 ? packets / getTickInterval() : 0;
+
+            this->setIntegerOnOutput(1, this->m_packets);
+            this->setIntegerOnOutput(2, this->m_bytes);
+        }
+
+    private:
+        u64 m_packets = 0, m_bytes = 0;
+        double m_packetRate = 0;
+    };
+
+    class NodePacketExtract : public Node {
+    public:
+        NodePacketExtract() : Node("hex.builtin.nodes.stream.extract.header",
+                                  { Attribute(Attribute::IOType::In, Attribute::Type::PacketStream, "hex.builtin.nodes.common.input"),
+                                    Attribute(Attribute::IOType::Out, Attribute::Type::Buffer, "hex.builtin.nodes.common.output") }) { }
+
+        void drawNode() override {
+            ImGui::PushItemWidth(100);
+            ImGui::InputInt("from", &this->m_from);
+            ImGui::InputInt("to", &this->m_to);
+            ImGui::PopItemWidth();
+            ImGui::Checkbox("payload only", &this->m_payloadOnly);
+        }
+
+        void process() override {
+            auto input = this->getTOnInput<PacketStream, Attribute::Type::PacketStream>(0);
+
+            if (this->m_from < 0 || this->m_to < this->m_from)
+                throwNodeError("Invalid byte range");
+
+            // Bytes [from, to) of the latest packet or its payload, keep the previous ones if nothing arrived
+            const auto selections = input->getSelections();
+            for (auto selection = selections.rbegin(); selection != selections.rend(); selection++) {
+                if (selection->indices.empty())
+                    continue;
+
+                const auto index = selection->indices.back();
+                const auto data  = this->m_payloadOnly ? selection->batch->getPayload(index) : selection->batch->getData(index);
+                const auto from = std::min<size_t>(this->m_from, data.size());
+                const auto to   = std::min<size_t>(this->m_to, data.size());
+
+                this->m_bytes = std::vector<u8>(data.begin() + from, data.begin() + to);
+                break;
+            }
+
+            this->setBufferOnOutput(1, this->m_bytes);
+        }
+
+        void store(nlohmann::json &j) override {
+            j = nlohmann::json::object();
+
+            j["from"]    = this->m_from;
+            j["to"]      = this->m_to;
+            j["payload"] = this->m_payloadOnly;
+        }
+
+        void load(nlohmann::json &j) override {
+            this->m_from        = j["from"];
+            this->m_to          = j["to"];
+            this->m_payloadOnly = j["payload"];
+        }
+
+    private:
+        int m_from = 0, m_to = 14;
+        bool m_payloadOnly = false;
+        SharedBuffer m_bytes;
+    };
+    
+    void registerNodes();
     
 
 } // namespace PcapEditor
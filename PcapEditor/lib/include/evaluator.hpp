@@ -0,0 +1,114 @@
+#pragma once
+#include <defination.hpp>
+#include <node.hpp>
+#include <profiler.hpp>
+#include <scheduler.hpp>
+#include <tick_scheduler.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace PcapEditor {
+
+    // Topology the evaluation thread works on. The UI builds a new one on every graph edit instead of
+    // letting the evaluation thread look at the links it is editing.
+    struct GraphSnapshot {
+        std::vector<Node *> nodes;
+        std::vector<Node *> endNodes;
+        std::vector<std::pair<Attribute *, Attribute *>> connections; // input, output feeding it
+    };
+
+    struct EvaluationResult {
+        u64 evaluation = 0;
+        std::vector<EvaluationError> errors; // Validation errors first, then the ones raised while processing
+        SchedulerReport report;
+        Profiler profiler;
+
+        std::vector<u32> foldedNodes;
+
+        // Continuous mode counters, see TickScheduler
+        u64 ticks = 0, missedDeadlines = 0, droppedTicks = 0;
+
+        [[nodiscard]] bool isFolded(u32 nodeId) const {
+            return std::find(this->foldedNodes.begin(), this->foldedNodes.end(), nodeId) != this->foldedNodes.end();
+        }
+
+        [[nodiscard]] const EvaluationError *getError(u32 nodeId) const {
+            auto error = std::find_if(this->errors.begin(), this->errors.end(), [nodeId](const auto &error) { return error.nodeId == nodeId; });
+
+            return error == this->errors.end() ? nullptr : &*error;
+        }
+    };
+
+    // Owns the thread evaluating the graph. Every public function only queues a command and returns,
+    // commands are applied between two evaluations.
+    class Evaluator {
+    public:
+        Evaluator();
+        ~Evaluator();
+
+        Evaluator(const Evaluator &) = delete;
+        Evaluator &operator=(const Evaluator &) = delete;
+
+        // Returns the snapshot's generation, compare with getAppliedSnapshot() before freeing nodes it no longer contains
+        u64 setSnapshot(GraphSnapshot snapshot);
+        void requestEvaluation();
+        void setContinuous(bool continuous);
+        void setTickRate(double rate);
+        void setTickPolicy(TickScheduler::Policy policy);
+
+        [[nodiscard]] u64 getAppliedSnapshot() const { return this->m_appliedSnapshot; }
+
+        // Copies the latest published result if it's newer than the one passed in
+        bool fetchResult(EvaluationResult &result);
+
+    private:
+        Scheduler m_scheduler;
+        Profiler m_profiler;
+
+        std::mutex m_commandMutex;
+        std::condition_variable m_commandCondition;
+        std::vector<std::function<void()>> m_commands;
+        bool m_stop = false;
+
+        GraphSnapshot m_snapshot;
+        std::vector<Node *> m_validEndNodes;
+        std::vector<EvaluationError> m_validationErrors;
+        std::unordered_map<Node *, std::vector<Overlay *>> m_dataOverlays;
+
+        // Nodes fed by constants only, the consumers each of them is folded into and the last seen parameter versions of the constants
+        std::vector<Node *> m_foldableNodes;
+        std::unordered_map<Node *, std::vector<Node *>> m_foldableConsumers;
+        std::unordered_map<Node *, u32> m_constantVersions;
+
+        bool m_continuous = false, m_evaluationRequested = false;
+        TickScheduler m_ticks;
+        TickScheduler::Clock::time_point m_lastEvaluation = TickScheduler::Clock::now();
+        u64 m_evaluationCounter = 0;
+
+        std::atomic<u64> m_snapshotCounter = 0, m_appliedSnapshot = 0;
+
+        std::mutex m_resultMutex;
+        EvaluationResult m_result;
+
+        std::thread m_thread;
+
+        void post(std::function<void()> command);
+        void threadLoop();
+        void applySnapshot(GraphSnapshot snapshot, u64 generation);
+        void validate();
+        void findFoldableNodes();
+        void unfold(Node *node);
+        void checkConstants();
+        void deleteOverlay(Node *endNode);
+        void evaluate(double tickInterval);
+    };
+
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <defination.hpp>
+#include <graph_registry.hpp>
+
+#include <array>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <imgui.h>
+#include <nlohmann/json_fwd.hpp>
+
+namespace PcapEditor {
+
+    // Saves and restores a whole graph: nodes with their parameters, attribute and link ids, id counters and
+    // node positions. Positions are passed in and out separately, they belong to imnodes.
+    //
+    // The JSON form is readable and built on Node::store/load. The binary form is what the editor saves by default:
+    //   magic "PCEG", u32 version, u32 node/attribute/link id counters
+    //   u32 type count, then per type: u16 length, name bytes
+    //   u32 node count, u32 attribute count, then per node: u32 id, u16 type index, f32 x, f32 y,
+    //       u16 attribute count, u32 attribute ids, u32 size, MessagePack of store()'s output (empty if it stored nothing)
+    //   u32 link count, then per link: u32 id, from, to
+    // All integers are little endian. Load reads the buffer in one pass and sizes every container up front.
+    class GraphFile {
+    public:
+        static constexpr std::array<u8, 4> Magic = { 'P', 'C', 'E', 'G' };
+        static constexpr u32 Version = 1;
+
+        using Positions = std::unordered_map<u32, ImVec2>;
+
+        static void storeJson(const GraphRegistry &graph, const Positions &positions, nlohmann::json &j);
+        [[nodiscard]] static std::vector<u8> storeBinary(const GraphRegistry &graph, const Positions &positions);
+
+        // Both add the nodes to an empty graph and throw std::runtime_error if the data is malformed or uses unknown node types
+        static void loadJson(const nlohmann::json &j, GraphRegistry &graph, Positions &positions);
+        static void loadBinary(std::span<const u8> data, GraphRegistry &graph, Positions &positions);
+
+        [[nodiscard]] static bool isBinary(std::span<const u8> data);
+    };
+
+}
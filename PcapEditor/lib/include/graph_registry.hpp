@@ -0,0 +1,55 @@
+#pragma once
+#include <defination.hpp>
+#include <attribute.hpp>
+#include <link.hpp>
+#include <node.hpp>
+
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace PcapEditor {
+
+    // Nodes, attributes and links of the editor's graph indexed by id. Every edit touches only the
+    // entries involved, nothing scans the whole graph.
+    class GraphRegistry {
+    public:
+        // Registers the node and its attributes, see Node::isEndNode
+        void addNode(Node *node);
+        // Sizes the indices up front before adding a whole graph
+        void reserve(size_t nodeCount, size_t attributeCount, size_t linkCount);
+        // Unregisters the nodes and erases every link touching them. The nodes are returned for the caller to free.
+        std::vector<Node *> eraseNodes(std::span<const int> ids);
+
+        // Connects the two attributes, returns nullptr if their types or directions don't match or the input is taken
+        const Link *addLink(u32 from, u32 to);
+        // Same, keeping the id the link had when it was saved
+        const Link *addLink(u32 id, u32 from, u32 to);
+        bool eraseLink(u32 id);
+
+        [[nodiscard]] Node *getNode(u32 id) const;
+        [[nodiscard]] Attribute *getAttribute(u32 id) const;
+        [[nodiscard]] const Link *getLink(u32 id) const;
+
+        [[nodiscard]] const std::vector<Node *> &getNodes() const { return this->m_nodes; }
+        [[nodiscard]] const std::vector<Node *> &getEndNodes() const { return this->m_endNodes; }
+        [[nodiscard]] const std::unordered_map<u32, Link> &getLinks() const { return this->m_links; }
+
+    private:
+        struct NodeEntry {
+            size_t index;
+            size_t endIndex; // NoIndex if it's not an end node
+        };
+
+        static constexpr size_t NoIndex = ~size_t(0);
+
+        std::vector<Node *> m_nodes, m_endNodes;
+        std::unordered_map<u32, NodeEntry> m_nodeEntries;
+        std::unordered_map<u32, Attribute *> m_attributes;
+        std::unordered_map<u32, Link> m_links;
+
+        // Swaps the last node into the erased slot
+        void removeAt(std::vector<Node *> &nodes, size_t index, size_t NodeEntry::*member);
+    };
+
+}
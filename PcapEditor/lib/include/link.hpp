@@ -17,6 +17,7 @@ namespace PcapEditor {
             if (id > Link::s_idCounter)
                 Link::s_idCounter = id;
         }
+        [[nodiscard]] static u32 getIdCounter() { return Link::s_idCounter; }
 
     private:
         u32 m_id;
@@ -2,11 +2,17 @@
 #include <iostream>
 #include <defination.hpp>
 #include <attribute.hpp>
+#include <shared_buffer.hpp>
+#include <slab_pool.hpp>
 #include <utility.hpp>
 
 
 #include <imgui.h>
-#include <set>
+#include <algorithm>
+#include <atomic>
+#include <initializer_list>
+#include <mutex>
+#include <span>
 #include <string_view>
 #include <vector>
 #include <cstdio>
@@ -28,34 +34,68 @@ namespace PcapEditor {
         [[nodiscard]] u64 getAddress() const { return this->m_address; }
 
         [[nodiscard]] u64 getSize() const { return this->m_data.size(); }
-        [[nodiscard]] std::vector<u8> &getData() { return this->m_data; }
+        [[nodiscard]] SharedBuffer &getData() { return this->m_data; }
 
     private:
         u64 m_address = 0;
-        std::vector<u8> m_data;
+        SharedBuffer m_data;
     };
     class Node {
     public:
-        Node(std::string unlocalizedTitle, std::vector<Attribute> attributes);
+        using Attributes = std::vector<Attribute, SlabAllocator<Attribute>>;
+
+        Node(std::string unlocalizedTitle, std::initializer_list<Attribute> attributes);
 
         virtual ~Node() = default;
 
+        // Nodes and their attributes live in the SlabPool, see utility::add
+        [[nodiscard]] static void *operator new(size_t size) { return SlabPool::getInstance().allocate(size); }
+        static void operator delete(void *pointer, size_t size) { SlabPool::getInstance().deallocate(pointer, size); }
+
         [[nodiscard]] u32 getId() const { return this->m_id; }
         void setId(u32 id) { this->m_id = id; }
+        // Takes fresh ids for the node and its attributes, for nodes joining a graph their ids weren't handed out for
+        void renewIds();
 
         [[nodiscard]] const std::string &getUnlocalizedName() const { return this->m_unlocalizedName; }
         void setUnlocalizedName(const std::string &unlocalizedName) { this->m_unlocalizedName = unlocalizedName; }
 
         [[nodiscard]] const std::string &getUnlocalizedTitle() const { return this->m_unlocalizedTitle; }
-        [[nodiscard]] std::vector<Attribute> &getAttributes() { return this->m_attributes; }
+        [[nodiscard]] Attributes &getAttributes() { return this->m_attributes; }
+
+        // Held by the evaluation thread while processing and by the UI while drawing
+        [[nodiscard]] std::mutex &getMutex() { return this->m_mutex; }
 
         void setCurrentOverlay(Overlay *overlay) {
             this->m_overlay = overlay;
         }
 
+        // The evaluator keeps one overlay per node writing data in an end node, groups hand them on to their end members
+        [[nodiscard]] virtual u32 getOverlayCount() { return 1; }
+        virtual void setCurrentOverlays(std::span<Overlay *const> overlays) { this->setCurrentOverlay(overlays.front()); }
+
+        // Nodes with inputs but no outputs end a chain, the evaluator runs everything they depend on
+        [[nodiscard]] virtual bool isEndNode();
+
         virtual void drawNode(){} 
         virtual void process() = 0;
 
+        // Nodes touching ImGui state or a capture device must return false so the scheduler keeps them on the evaluating thread
+        [[nodiscard]] virtual bool isThreadSafe() const { return true; }
+
+        // Sources whose outputs only depend on their parameters, see store()
+        [[nodiscard]] virtual bool isConstant() const { return false; }
+        // Nodes whose outputs only depend on their inputs. Fed by constants only, they're evaluated once and folded.
+        [[nodiscard]] virtual bool isPure() const { return false; }
+
+        // Folded nodes keep their outputs between evaluations and aren't processed
+        [[nodiscard]] bool isFolded() const { return this->m_folded; }
+        void setFolded(bool folded) { this->m_folded = folded; }
+
+        // Bumped by a node whenever one of its parameters changes, the evaluator compares it to refold constants
+        [[nodiscard]] u32 getParameterVersion() const { return this->m_parameterVersion.load(std::memory_order_relaxed); }
+        void markParametersChanged() { this->m_parameterVersion.fetch_add(1, std::memory_order_relaxed); }
+
 
         virtual void store(nlohmann::json &j) { }
         virtual void load(nlohmann::json &j) { }
@@ -69,46 +109,71 @@ namespace PcapEditor {
 
         void resetProcessedInputs() {
             this->m_processedInputs.clear();
+            this->m_processed = false;
         }
 
+        [[nodiscard]] bool isProcessed() const { return this->m_processed; }
+        void setProcessed() { this->m_processed = true; }
+
         static void setIdCounter(u32 id) {
             if (id > Node::s_idCounter)
                 Node::s_idCounter = id;
         }
+        [[nodiscard]] static u32 getIdCounter() { return Node::s_idCounter; }
+
+        // Seconds covered by the evaluation in progress, set by the evaluator before it runs the graph
+        static void setTickInterval(double seconds) { Node::s_tickInterval = seconds; }
 
     private:
         u32 m_id;
         std::string m_unlocalizedTitle, m_unlocalizedName;
-        std::vector<Attribute> m_attributes;
-        std::set<u32> m_processedInputs;
+        Attributes m_attributes;
+        std::vector<u32> m_processedInputs;
+        bool m_processed = false;
+        bool m_folded = false;
+        std::atomic<u32> m_parameterVersion = 0;
         Overlay *m_overlay = nullptr;
+        std::mutex m_mutex;
 
         static u32 s_idCounter;
+        static double s_tickInterval;
 
         Attribute *getConnectedInputAttribute(u32 index) {
             if (index >= this->getAttributes().size())
                 throw std::runtime_error("Attribute index out of bounds!");
 
-            auto &connectedAttribute = this->getAttributes()[index].getConnectedAttributes();
-
-            if (connectedAttribute.empty())
-                return nullptr;
-
-            return connectedAttribute.begin()->second;
+            return this->getAttributes()[index].getInputSource();
         }
 
         void markInputProcessed(u32 index) {
-            const auto &[iter, inserted] = this->m_processedInputs.insert(index);
-            if (!inserted)
+            if (std::find(this->m_processedInputs.begin(), this->m_processedInputs.end(), index) != this->m_processedInputs.end())
                 throwNodeError("Recursion detected!");
+
+            this->m_processedInputs.push_back(index);
+        }
+
+        // Inputs already evaluated by the scheduler are only read, everything else is pulled on demand
+        void processInput(Attribute *attribute) {
+            auto parent = attribute->getParentNode();
+            if (parent->isProcessed())
+                return;
+
+            parent->process();
+            parent->setProcessed();
         }
 
     protected:
+        // For nodes whose attributes depend on their parameters, only before the node is added to a graph
+        void setAttributes(Attributes attributes);
+
+        // Rate-based nodes divide by this instead of measuring time themselves
+        [[nodiscard]] static double getTickInterval() { return Node::s_tickInterval; }
+
         [[noreturn]] void throwNodeError(const std::string &message) {
             throw NodeError(this, message);
         }
 
-        std::vector<u8> getBufferOnInput(u32 index);
+        SharedBuffer getBufferOnInput(u32 index);
         std::string getStringOnInput(u32 index);
         u64 getIntegerOnInput(u32 index);
         float getFloatOnInput(u32 index);
@@ -119,7 +184,7 @@ namespace PcapEditor {
         // T* getTOnInput(u32 index);
 
 
-        void setBufferOnOutput(u32 index, std::vector<u8> data);
+        void setBufferOnOutput(u32 index, SharedBuffer data);
         void setStringOnOutput(u32 index, std::string data);
         void setIntegerOnOutput(u32 index, u64 integer);
         void setFloatOnOutput(u32 index, float floatingPoint);
@@ -146,13 +211,16 @@ namespace PcapEditor {
                 throw std::runtime_error("Tried to read buffer from non-buffer attribute");
 
             markInputProcessed(index);
-            attribute->getParentNode()->process();
+            this->processInput(attribute);
 
             auto &outputData = attribute->getOutputData();
 
-            if (!outputData.has_value())
+            if (!outputData.hasValue())
                 throw std::runtime_error("No data available at connected attribute");
-            return reinterpret_cast<T *>(*reinterpret_cast<u64 *>(outputData->data()));
+            if (outputData.getKind() != OutputSlot::Kind::Pointer)
+                throw std::runtime_error("No pointer available at connected attribute");
+
+            return static_cast<T *>(outputData.getPointer());
         }
         template<class T>
         void setTOnOutput(u32 index, T * packet) {
@@ -164,13 +232,10 @@ namespace PcapEditor {
             if (attribute.getIOType() != Attribute::IOType::Out)
                 throw std::runtime_error("Tried to set output data of an input attribute!");
 
-            std::vector<u8> buffer(sizeof(T* ), 0);
-            std::memcpy(buffer.data(), &packet, sizeof(T* ));
-
-            attribute.getOutputData() = buffer;
+            attribute.getOutputData().setPointer(packet);
         }
 
-        void setOverlayData(u64 address, const std::vector<u8> &data);
+        void setOverlayData(u64 address, SharedBuffer data);
     };
 
    
@@ -0,0 +1,86 @@
+#pragma once
+#include <defination.hpp>
+#include <graph_registry.hpp>
+#include <node.hpp>
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <imgui.h>
+#include <nlohmann/json_fwd.hpp>
+
+namespace PcapEditor {
+
+    // A subgraph collapsed into a single node. The group owns its members and the links between them. Each pin
+    // stands for one member attribute: every input not fed from inside the group and every output used outside
+    // of it or not at all.
+    //
+    // The editor submits and hit-tests the group as one node, the evaluator schedules it as one task that runs the
+    // members in dependency order. Members can't be edited while collapsed, expand the group to change them.
+    class NodeGroup : public Node {
+    public:
+        static constexpr std::string_view UnlocalizedName = "hex.builtin.nodes.group";
+        static constexpr std::string_view TemplateCategory = "hex.builtin.nodes.templates";
+
+        struct Member {
+            Node *node;
+            ImVec2 offset; // From the group's position in grid space
+        };
+
+        NodeGroup();
+        ~NodeGroup() override;
+
+        // An empty group, its members come from load()
+        [[nodiscard]] static NodeGroup *create();
+
+        // Moves the nodes with the given ids out of the graph into a new group that takes their place. Links between them
+        // move into the group, links crossing its boundary are reconnected to its pins. positions are the nodes' grid
+        // positions in the same order as ids, position is set to where the group goes.
+        static NodeGroup *collapse(GraphRegistry &graph, std::span<const int> ids, std::span<const ImVec2> positions, ImVec2 &position);
+        // The opposite: erases the group from the graph, adds its members back with fresh ids and reconnects the group's
+        // links to them. The empty group is left for the caller to free.
+        std::vector<Member> expand(GraphRegistry &graph);
+
+        // Adds the group's current definition to the node palette under the group's name
+        void addTemplate();
+
+        [[nodiscard]] const std::vector<Member> &getMembers() const { return this->m_members; }
+
+        void drawNode() override;
+        void process() override;
+
+        [[nodiscard]] bool isThreadSafe() const override { return this->m_threadSafe; }
+        [[nodiscard]] bool isConstant() const override { return this->m_constant; }
+        [[nodiscard]] bool isPure() const override { return this->m_pure; }
+        [[nodiscard]] bool isEndNode() override;
+        [[nodiscard]] u32 getOverlayCount() override;
+        void setCurrentOverlays(std::span<Overlay *const> overlays) override;
+
+        void store(nlohmann::json &j) override;
+        void load(nlohmann::json &j) override;
+
+    private:
+        struct InnerLink {
+            Attribute *from, *to;
+        };
+
+        std::string m_name;
+        std::vector<Member> m_members; // In dependency order
+        std::vector<InnerLink> m_links;
+        std::vector<Attribute *> m_pinTargets; // Member attribute behind each of the group's attributes
+        bool m_wired = false;
+
+        // Fixed while the members are, read by the evaluator without locking the group
+        bool m_threadSafe = true, m_constant = false, m_pure = false;
+        std::vector<Node *> m_endMembers;
+
+        // Creates the group's attributes for the pin targets, sorts the members and sums up their properties
+        void buildPins();
+        void sortMembers();
+        // Links the members among each other and fuses their operator chains, once on the evaluating thread
+        void wireMembers();
+    };
+
+}
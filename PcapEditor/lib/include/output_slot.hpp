@@ -0,0 +1,156 @@
+#pragma once
+#include <defination.hpp>
+#include <shared_buffer.hpp>
+
+#include <cstring>
+#include <new>
+#include <span>
+#include <string_view>
+#include <utility>
+
+namespace PcapEditor {
+
+    // Value produced on an output attribute. Integers, floats, pointers and short strings live inline,
+    // large strings and buffers are shared with the producer through a SharedBuffer.
+    class OutputSlot {
+    public:
+        enum class Kind : u8 {
+            Empty,
+            Integer,
+            Float,
+            Pointer,
+            String,
+            Buffer
+        };
+
+        static constexpr size_t InlineStringSize = sizeof(SharedBuffer);
+
+        OutputSlot() : m_integer(0) { }
+        OutputSlot(const OutputSlot &other) { this->copyFrom(other); }
+        OutputSlot(OutputSlot &&other) noexcept { this->moveFrom(std::move(other)); }
+        ~OutputSlot() { this->reset(); }
+
+        OutputSlot &operator=(const OutputSlot &other) {
+            if (this != &other) {
+                this->reset();
+                this->copyFrom(other);
+            }
+            return *this;
+        }
+
+        OutputSlot &operator=(OutputSlot &&other) noexcept {
+            if (this != &other) {
+                this->reset();
+                this->moveFrom(std::move(other));
+            }
+            return *this;
+        }
+
+        [[nodiscard]] Kind getKind() const { return this->m_kind; }
+        [[nodiscard]] bool hasValue() const { return this->m_kind != Kind::Empty; }
+
+        void reset() {
+            if (this->m_kind == Kind::Buffer)
+                this->m_buffer.~SharedBuffer();
+            this->m_kind = Kind::Empty;
+        }
+
+        void setInteger(u64 value) {
+            this->reset();
+            this->m_integer = value;
+            this->m_kind    = Kind::Integer;
+        }
+
+        void setFloat(float value) {
+            this->reset();
+            this->m_float = value;
+            this->m_kind  = Kind::Float;
+        }
+
+        void setPointer(void *value) {
+            this->reset();
+            this->m_pointer = value;
+            this->m_kind    = Kind::Pointer;
+        }
+
+        void setString(std::string_view value) {
+            if (value.size() > InlineStringSize) {
+                this->setBuffer(std::vector<u8>(value.begin(), value.end()));
+                return;
+            }
+
+            this->reset();
+            std::memcpy(this->m_string, value.data(), value.size());
+            this->m_stringSize = static_cast<u8>(value.size());
+            this->m_kind       = Kind::String;
+        }
+
+        void setBuffer(SharedBuffer value) {
+            if (this->m_kind == Kind::Buffer) {
+                this->m_buffer = std::move(value);
+                return;
+            }
+
+            this->reset();
+            new (&this->m_buffer) SharedBuffer(std::move(value));
+            this->m_kind = Kind::Buffer;
+        }
+
+        [[nodiscard]] u64 getInteger() const { return this->m_integer; }
+        [[nodiscard]] float getFloat() const { return this->m_float; }
+        [[nodiscard]] void *getPointer() const { return this->m_pointer; }
+        [[nodiscard]] const SharedBuffer &getBuffer() const { return this->m_buffer; }
+
+        // Raw bytes of whatever is stored, for readers whose pin type doesn't match the producer's slot kind
+        [[nodiscard]] std::span<const u8> getBytes() const {
+            switch (this->m_kind) {
+                case Kind::Integer:
+                    return { reinterpret_cast<const u8 *>(&this->m_integer), sizeof(u64) };
+                case Kind::Float:
+                    return { reinterpret_cast<const u8 *>(&this->m_float), sizeof(float) };
+                case Kind::Pointer:
+                    return { reinterpret_cast<const u8 *>(&this->m_pointer), sizeof(void *) };
+                case Kind::String:
+                    return { reinterpret_cast<const u8 *>(this->m_string), this->m_stringSize };
+                case Kind::Buffer:
+                    return this->m_buffer.span();
+                default:
+                    return { };
+            }
+        }
+
+    private:
+        Kind m_kind = Kind::Empty;
+        u8 m_stringSize = 0;
+
+        union {
+            u64 m_integer;
+            float m_float;
+            void *m_pointer;
+            char m_string[InlineStringSize];
+            SharedBuffer m_buffer;
+        };
+
+        void copyFrom(const OutputSlot &other) {
+            if (other.m_kind == Kind::Buffer) {
+                new (&this->m_buffer) SharedBuffer(other.m_buffer);
+            } else {
+                std::memcpy(this->m_string, other.m_string, InlineStringSize);
+                this->m_stringSize = other.m_stringSize;
+            }
+            this->m_kind = other.m_kind;
+        }
+
+        void moveFrom(OutputSlot &&other) {
+            if (other.m_kind == Kind::Buffer) {
+                new (&this->m_buffer) SharedBuffer(std::move(other.m_buffer));
+            } else {
+                std::memcpy(this->m_string, other.m_string, InlineStringSize);
+                this->m_stringSize = other.m_stringSize;
+            }
+            this->m_kind = other.m_kind;
+            other.reset();
+        }
+    };
+
+}
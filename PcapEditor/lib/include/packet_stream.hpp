@@ -0,0 +1,152 @@
+#pragma once
+#include <defination.hpp>
+
+#include <atomic>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <pcapplusplus/ProtocolType.h>
+#include <pcapplusplus/RawPacket.h>
+
+namespace PcapEditor {
+
+    // 128-bit address column entry, IPv4 addresses are stored IPv4-mapped (::ffff:a.b.c.d)
+    struct PacketAddress {
+        u64 high = 0, low = 0;
+
+        bool operator==(const PacketAddress &) const = default;
+    };
+
+    // Fixed-capacity block of captured packets stored as columns. Headers are parsed once when a packet is pushed,
+    // per-packet nodes then run plain loops over the columns instead of walking pcpp layers.
+    // The bytes are copied into an arena reserved up front. Once handed to the graph a batch is read-only.
+    class PacketBatch {
+    public:
+        static constexpr size_t ArenaSize = 1024 * 1024, MaxPackets = 1024;
+        // Offset column value of a layer the packet doesn't have
+        static constexpr u16 NoOffset = 0xFFFF;
+
+        PacketBatch();
+
+        PacketBatch(const PacketBatch &) = delete;
+        PacketBatch &operator=(const PacketBatch &) = delete;
+
+        // Copies the packet and parses its headers into the columns, returns the row or -1 if the batch is full
+        i32 push(std::span<const u8> data, u32 wireLength, timespec timestamp, pcpp::LinkLayerType linkType = pcpp::LINKTYPE_ETHERNET);
+        i32 push(const pcpp::RawPacket &packet);
+        void clear();
+
+        [[nodiscard]] size_t size() const { return this->m_timestamps.size(); }
+        [[nodiscard]] bool empty() const { return this->m_timestamps.empty(); }
+        [[nodiscard]] u64 getByteCount() const { return this->m_arena.size(); }
+
+        [[nodiscard]] std::span<const u64> getTimestamps() const { return this->m_timestamps; } // Nanoseconds since the epoch
+        [[nodiscard]] std::span<const u32> getWireLengths() const { return this->m_wireLengths; }
+        [[nodiscard]] std::span<const u32> getCapturedLengths() const { return this->m_capturedLengths; }
+        [[nodiscard]] std::span<const u16> getL3Offsets() const { return this->m_l3Offsets; }
+        [[nodiscard]] std::span<const u16> getL4Offsets() const { return this->m_l4Offsets; }
+        [[nodiscard]] std::span<const pcpp::ProtocolType> getProtocols() const { return this->m_protocols; }
+        [[nodiscard]] std::span<const PacketAddress> getSrcAddresses() const { return this->m_srcAddresses; }
+        [[nodiscard]] std::span<const PacketAddress> getDstAddresses() const { return this->m_dstAddresses; }
+        [[nodiscard]] std::span<const u16> getSrcPorts() const { return this->m_srcPorts; }
+        [[nodiscard]] std::span<const u16> getDstPorts() const { return this->m_dstPorts; }
+        [[nodiscard]] std::span<const u8> getIpProtocols() const { return this->m_ipProtocols; }
+
+        [[nodiscard]] std::span<const u8> getData(u32 index) const { return { this->m_arena.data() + this->m_dataOffsets[index], this->m_capturedLengths[index] }; }
+        [[nodiscard]] std::span<const u8> getPayload(u32 index) const { return { this->m_arena.data() + this->m_payloadOffsets[index], this->m_payloadLengths[index] }; }
+
+    private:
+        std::vector<u8> m_arena;
+
+        std::vector<u64> m_timestamps;
+        std::vector<u32> m_wireLengths, m_capturedLengths, m_dataOffsets;
+        std::vector<u16> m_l3Offsets, m_l4Offsets;
+        std::vector<pcpp::ProtocolType> m_protocols;
+        std::vector<PacketAddress> m_srcAddresses, m_dstAddresses;
+        std::vector<u16> m_srcPorts, m_dstPorts;
+        std::vector<u8> m_ipProtocols;
+        std::vector<u32> m_payloadOffsets, m_payloadLengths;
+    };
+
+    namespace kernels {
+
+        // Appends the rows of indices whose protocol bitmask intersects mask to selected
+        void selectProtocols(const PacketBatch &batch, std::span<const u32> indices, pcpp::ProtocolType mask, std::vector<u32> &selected);
+        // Sum of the wire lengths of the rows in indices
+        [[nodiscard]] u64 sumWireLengths(const PacketBatch &batch, std::span<const u32> indices);
+        // Symmetric 5-tuple hash per row, both directions of a flow hash to the same value
+        void hashFlows(const PacketBatch &batch, std::span<const u32> indices, std::vector<u64> &hashes);
+
+    }
+
+    // Recycles batches between the capture threads and the graph. Batches go back to the pool when the last
+    // stream referencing them lets go.
+    class PacketBatchPool {
+    public:
+        static constexpr size_t MaxFreeBatches = 16;
+
+        [[nodiscard]] static PacketBatchPool &getInstance();
+
+        [[nodiscard]] std::shared_ptr<PacketBatch> acquire();
+
+        [[nodiscard]] u64 getAllocatedBatches() const { return this->m_allocatedBatches; }
+
+    private:
+        PacketBatchPool() = default;
+
+        void release(PacketBatch *batch);
+
+        std::mutex m_mutex;
+        std::vector<std::unique_ptr<PacketBatch>> m_freeBatches;
+        u64 m_allocatedBatches = 0;
+    };
+
+    // Batches filled by a capture thread and drained by the node owning the device on the evaluation thread
+    class PacketCapture {
+    public:
+        // Packets arriving while this many batches are waiting to be drained are dropped
+        static constexpr size_t MaxPendingBatches = 64;
+
+        // Called from the capture thread, returns the packet's protocol bitmask or nothing if it was dropped
+        std::optional<pcpp::ProtocolType> push(const pcpp::RawPacket &packet);
+        // Moves every batch captured so far, including the one being filled, into batches
+        void drain(std::vector<std::shared_ptr<PacketBatch>> &batches);
+        void clear();
+
+        [[nodiscard]] u64 getDroppedPackets() const { return this->m_droppedPackets; }
+
+    private:
+        std::mutex m_mutex;
+        std::shared_ptr<PacketBatch> m_current;
+        std::vector<std::shared_ptr<PacketBatch>> m_pending;
+        std::atomic<u64> m_droppedPackets = 0;
+    };
+
+    // Value of a packet stream pin for one evaluation: the batches that arrived since the previous one,
+    // each with the packets still selected by the nodes upstream
+    class PacketStream {
+    public:
+        struct Selection {
+            std::shared_ptr<PacketBatch> batch;
+            std::vector<u32> indices;
+        };
+
+        // Starts a new evaluation, keeps the index storage around
+        void clear();
+        // Selects every packet of the batch
+        void addBatch(std::shared_ptr<PacketBatch> batch);
+        // Starts an empty selection on the batch, fill it through the returned vector
+        std::vector<u32> &addSelection(std::shared_ptr<PacketBatch> batch);
+
+        [[nodiscard]] std::span<const Selection> getSelections() const { return { this->m_selections.data(), this->m_selectionCount }; }
+
+    private:
+        std::vector<Selection> m_selections;
+        size_t m_selectionCount = 0;
+    };
+
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <defination.hpp>
+#include <node.hpp>
+#include <packet_stream.hpp>
+
+#include <span>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace PcapEditor {
+
+    // Per-packet predicates a stream node can be reduced to. Each one only reads the columns of the batch.
+    struct ProtocolOperator {
+        pcpp::ProtocolType mask;
+
+        [[nodiscard]] bool test(const PacketBatch &batch, u32 index) const { return (batch.getProtocols()[index] & this->mask) != 0; }
+        bool operator==(const ProtocolOperator &) const = default;
+    };
+
+    struct PortOperator {
+        u16 port;
+
+        [[nodiscard]] bool test(const PacketBatch &batch, u32 index) const {
+            return (batch.getSrcPorts()[index] == this->port) | (batch.getDstPorts()[index] == this->port);
+        }
+        bool operator==(const PortOperator &) const = default;
+    };
+
+    struct LengthOperator {
+        u32 min, max;
+
+        [[nodiscard]] bool test(const PacketBatch &batch, u32 index) const {
+            const auto length = batch.getWireLengths()[index];
+            return (length >= this->min) & (length <= this->max);
+        }
+        bool operator==(const LengthOperator &) const = default;
+    };
+
+    using PacketOperator = std::variant<ProtocolOperator, PortOperator, LengthOperator>;
+
+    // A chain of operators compiled into kernels running all of them in a single pass over the selection, tile by tile.
+    // Every combination of up to MaxFusedOperators operators is instantiated at compile time, longer chains
+    // are split into several of those passes.
+    class PacketPipeline {
+    public:
+        static constexpr size_t MaxFusedOperators = 3;
+
+        // Only rebuilds the kernels if the operators changed
+        void compile(std::span<const PacketOperator> operators);
+        // Appends the rows of indices passing every operator to selected
+        void run(const PacketBatch &batch, std::span<const u32> indices, std::vector<u32> &selected) const;
+
+        [[nodiscard]] size_t getOperatorCount() const { return this->m_operators.size(); }
+        [[nodiscard]] size_t getPassCount() const { return this->m_passes.size(); }
+
+    private:
+        // Writes the rows passing the operators to out and returns how many there are, out may alias in
+        using Kernel = size_t (*)(const PacketOperator *operators, const PacketBatch &batch, const u32 *in, size_t count, u32 *out);
+
+        struct Pass {
+            Kernel kernel;
+            size_t firstOperator;
+        };
+
+        std::vector<PacketOperator> m_operators;
+        std::vector<Pass> m_passes;
+    };
+
+    // Stream node whose work is a single PacketOperator. Linear chains of these get fused on every graph change:
+    // the last node of the chain runs the whole chain's pipeline on the stream entering the first one, the
+    // others don't do anything anymore.
+    class PacketOperatorNode : public Node {
+    public:
+        explicit PacketOperatorNode(std::string unlocalizedTitle);
+
+        void process() final;
+
+        // Parameters of the node as an operator, read once per evaluation
+        [[nodiscard]] virtual PacketOperator getOperator() const = 0;
+
+        // Re-links the chains among nodes, connections are the same as in the GraphSnapshot
+        static void fuseChains(const std::vector<Node *> &nodes, const std::vector<std::pair<Attribute *, Attribute *>> &connections);
+
+    private:
+        PacketOperatorNode *m_fusedInto = nullptr;
+        std::vector<PacketOperatorNode *> m_chain; // Head first, only set on the last node of a fused chain
+
+        std::vector<PacketOperator> m_operators;
+        PacketPipeline m_pipeline;
+        PacketStream m_stream;
+    };
+
+}
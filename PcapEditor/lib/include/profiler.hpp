@@ -0,0 +1,44 @@
+#pragma once
+#include <defination.hpp>
+#include <node.hpp>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json_fwd.hpp>
+
+namespace PcapEditor {
+
+    struct SchedulerReport;
+
+    struct NodeProfile {
+        u32 nodeId = 0;
+        std::string title;
+        u64 calls = 0;
+        double lastMilliseconds = 0, averageMilliseconds = 0;
+        u64 lastAllocations = 0, totalAllocations = 0;
+        std::vector<u64> outputBytes; // Per output attribute, last call
+    };
+
+    // Accumulates the per-node timings of every evaluation into call counts and rolling averages
+    class Profiler {
+    public:
+        // Weight of the newest sample in the rolling averages
+        static constexpr double Smoothing = 0.1;
+
+        void record(const SchedulerReport &report);
+        // Drops the profiles of nodes that are no longer part of the graph
+        void retain(const std::vector<Node *> &nodes);
+
+        [[nodiscard]] const NodeProfile *get(u32 nodeId) const;
+        [[nodiscard]] const std::unordered_map<u32, NodeProfile> &getProfiles() const { return this->m_profiles; }
+        [[nodiscard]] double getMaxAverageMilliseconds() const { return this->m_maxAverageMilliseconds; }
+
+        void store(nlohmann::json &j) const;
+
+    private:
+        std::unordered_map<u32, NodeProfile> m_profiles;
+        double m_maxAverageMilliseconds = 0;
+    };
+
+}
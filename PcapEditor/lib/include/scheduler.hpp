@@ -0,0 +1,72 @@
+#pragma once
+#include <defination.hpp>
+#include <node.hpp>
+#include <shared_buffer.hpp>
+#include <thread_pool.hpp>
+
+#include <exception>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace PcapEditor {
+
+    struct NodeTiming {
+        u32 nodeId;
+        std::string title;
+        double milliseconds;
+        bool pinned;
+        u64 allocations;
+        std::vector<u64> outputBytes;
+    };
+
+    struct EvaluationError {
+        u32 nodeId;
+        std::string message;
+    };
+
+    struct SchedulerReport {
+        std::vector<NodeTiming> timings;
+        std::vector<EvaluationError> errors;
+        double wallMilliseconds = 0;
+        double busyMilliseconds = 0;
+        u64 bytesCopied = 0;
+        u32 workerCount = 0;
+    };
+
+    // Evaluates the subgraph feeding the end nodes as a DAG: every node runs once, as soon as all of its inputs are done.
+    // Thread-safe nodes are spread over the pool, the others are pinned to the thread calling evaluate().
+    // A node raising a NodeError only takes its downstream branch with it, the other branches keep running.
+    class Scheduler {
+    public:
+        explicit Scheduler(u32 workerCount = 0) : m_pool(workerCount) { }
+
+        // NodeErrors end up in the report. Any other exception stops scheduling and is rethrown once all running nodes have finished
+        void evaluate(const std::vector<Node *> &endNodes);
+
+        [[nodiscard]] const SchedulerReport &getReport() const { return this->m_report; }
+
+    private:
+        struct Task {
+            Node *node;
+            std::vector<u32> dependents;
+            std::atomic<u32> remainingInputs = 0;
+            std::atomic<bool> skipped = false; // An input failed or was skipped
+        };
+
+        ThreadPool m_pool;
+        std::vector<Task> m_tasks;
+        std::atomic<u32> m_outstanding = 0;
+        std::atomic<bool> m_aborted = false;
+
+        std::mutex m_resultMutex;
+        std::exception_ptr m_error;
+        SchedulerReport m_report;
+
+        void buildTasks(const std::vector<Node *> &endNodes);
+        void schedule(u32 index);
+        void run(u32 index);
+    };
+
+}
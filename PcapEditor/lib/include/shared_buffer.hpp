@@ -0,0 +1,60 @@
+#pragma once
+#include <defination.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace PcapEditor {
+
+    // Immutable, reference-counted view into a byte buffer. Copies of a SharedBuffer and slices share storage,
+    // only mutate() and toVector() ever copy bytes.
+    class SharedBuffer {
+    public:
+        SharedBuffer() = default;
+        SharedBuffer(std::vector<u8> data) : m_storage(std::make_shared<std::vector<u8>>(std::move(data))) { }
+
+        [[nodiscard]] const u8 *data() const { return this->m_storage ? this->m_storage->data() + this->m_offset : nullptr; }
+        [[nodiscard]] size_t size() const {
+            if (!this->m_storage)
+                return 0;
+
+            return std::min(this->m_size, this->m_storage->size() - this->m_offset);
+        }
+        [[nodiscard]] bool empty() const { return this->size() == 0; }
+
+        [[nodiscard]] const u8 *begin() const { return this->data(); }
+        [[nodiscard]] const u8 *end() const { return this->data() + this->size(); }
+        [[nodiscard]] u8 operator[](size_t index) const { return this->data()[index]; }
+
+        [[nodiscard]] std::span<const u8> span() const { return { this->data(), this->size() }; }
+
+        // View of the bytes [from, to) sharing this buffer's storage
+        [[nodiscard]] SharedBuffer slice(size_t from, size_t to) const {
+            SharedBuffer result = *this;
+            result.m_offset += from;
+            result.m_size = to - from;
+
+            return result;
+        }
+
+        // Copy-on-write access, the storage is only copied if it's shared or this is a partial view
+        [[nodiscard]] std::vector<u8> &mutate();
+
+        [[nodiscard]] std::vector<u8> toVector() const;
+
+        [[nodiscard]] static u64 getBytesCopied() { return s_bytesCopied; }
+
+    private:
+        static constexpr size_t WholeStorage = std::numeric_limits<size_t>::max();
+
+        std::shared_ptr<std::vector<u8>> m_storage;
+        size_t m_offset = 0, m_size = WholeStorage;
+
+        static std::atomic<u64> s_bytesCopied;
+    };
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <defination.hpp>
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace PcapEditor {
+
+    // Size-classed free lists carved out of large slabs. Nodes and their attributes are allocated from here so a
+    // graph ends up packed into a few contiguous blocks instead of being scattered over the heap.
+    // Slabs are never given back, freed blocks are reused by the next allocation of the same size class.
+    class SlabPool {
+    public:
+        static constexpr size_t SlabSize = 64 * 1024, Granularity = 16, MaxBlockSize = 2048;
+
+        [[nodiscard]] static SlabPool &getInstance();
+
+        // Blocks bigger than MaxBlockSize come from the global heap
+        [[nodiscard]] void *allocate(size_t size);
+        void deallocate(void *pointer, size_t size);
+
+        [[nodiscard]] u64 getSlabCount() const { return this->m_slabs.size(); }
+        [[nodiscard]] u64 getBytesInUse() const { return this->m_bytesInUse; }
+
+    private:
+        SlabPool() = default;
+
+        struct FreeBlock {
+            FreeBlock *next;
+        };
+
+        std::mutex m_mutex;
+        std::array<FreeBlock *, MaxBlockSize / Granularity> m_freeLists = { };
+        std::vector<std::unique_ptr<std::byte[]>> m_slabs;
+        std::byte *m_cursor = nullptr, *m_end = nullptr;
+        u64 m_bytesInUse = 0;
+    };
+
+    // Standard allocator on top of the SlabPool, for containers owned by nodes
+    template<class T>
+    struct SlabAllocator {
+        static_assert(alignof(T) <= SlabPool::Granularity);
+
+        using value_type = T;
+
+        SlabAllocator() = default;
+        template<class U>
+        SlabAllocator(const SlabAllocator<U> &) { }
+
+        [[nodiscard]] T *allocate(size_t count) { return static_cast<T *>(SlabPool::getInstance().allocate(count * sizeof(T))); }
+        void deallocate(T *pointer, size_t count) { SlabPool::getInstance().deallocate(pointer, count * sizeof(T)); }
+
+        bool operator==(const SlabAllocator &) const { return true; }
+    };
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <defination.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace PcapEditor {
+
+    class ThreadPool {
+    public:
+        using Task = std::function<void()>;
+
+        // workerCount == 0 picks one worker per hardware thread, minus the calling thread
+        explicit ThreadPool(u32 workerCount = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        // Queues a task on the local queue of the calling worker, or round-robin when called from outside the pool
+        void submit(Task task);
+        // Queues a task that may only run on the thread blocked in waitUntil()
+        void submitPinned(Task task);
+
+        // Runs pinned tasks and steals pool work on the calling thread until done() returns true
+        void waitUntil(const std::function<bool()> &done);
+        // Wakes a thread blocked in waitUntil() so it re-checks its condition
+        void notifyWaiter();
+
+        [[nodiscard]] u32 getWorkerCount() const { return static_cast<u32>(this->m_workers.size()); }
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::unique_ptr<Queue>> m_queues;
+        Queue m_pinnedQueue;
+        std::vector<std::thread> m_workers;
+
+        std::mutex m_sleepMutex;
+        std::condition_variable m_workerCondition, m_waiterCondition;
+        std::atomic<u32> m_queuedTasks = 0;
+        std::atomic<u32> m_nextQueue = 0;
+        bool m_stop = false;
+
+        void workerLoop(u32 index);
+        bool popLocal(u32 index, Task &task);
+        bool steal(u32 thief, Task &task);
+        bool popPinned(Task &task);
+    };
+
+}
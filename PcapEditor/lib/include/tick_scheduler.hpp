@@ -0,0 +1,55 @@
+#pragma once
+#include <defination.hpp>
+
+#include <chrono>
+
+namespace PcapEditor {
+
+    // Fixed-rate clock for continuous evaluation, independent from how often the UI renders.
+    // Every tick has a deadline; a tick starting after the next deadline already passed missed it.
+    class TickScheduler {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        enum class Policy {
+            Skip,   // Evaluate once and drop the ticks that were missed
+            CatchUp // Evaluate the missed ticks back to back, up to MaxCatchUpTicks
+        };
+
+        static constexpr double DefaultRate = 60.0, MinRate = 0.1, MaxRate = 1000.0;
+        static constexpr u32 MaxCatchUpTicks = 4;
+
+        explicit TickScheduler(double rate = DefaultRate, Policy policy = Policy::Skip);
+
+        // Clamped to [MinRate, MaxRate] ticks per second
+        void setRate(double rate);
+        [[nodiscard]] double getRate() const { return this->m_rate; }
+        [[nodiscard]] Clock::duration getInterval() const { return this->m_interval; }
+
+        void setPolicy(Policy policy) { this->m_policy = policy; }
+        [[nodiscard]] Policy getPolicy() const { return this->m_policy; }
+
+        // Makes the first tick due immediately
+        void start(Clock::time_point now);
+        [[nodiscard]] Clock::time_point getDeadline() const { return this->m_deadline; }
+
+        // Number of ticks to evaluate at `now`, the deadline is moved past all of them
+        [[nodiscard]] u32 advance(Clock::time_point now);
+
+        [[nodiscard]] u64 getTicks() const { return this->m_ticks; }
+        [[nodiscard]] u64 getMissedDeadlines() const { return this->m_missedDeadlines; }
+        [[nodiscard]] u64 getDroppedTicks() const { return this->m_droppedTicks; }
+        // Ticks dropped by the last advance(), the first evaluation it returned has to account for them
+        [[nodiscard]] u32 getLastDroppedTicks() const { return this->m_lastDroppedTicks; }
+
+    private:
+        double m_rate = DefaultRate;
+        Clock::duration m_interval {};
+        Policy m_policy;
+        Clock::time_point m_deadline;
+
+        u64 m_ticks = 0, m_missedDeadlines = 0, m_droppedTicks = 0;
+        u32 m_lastDroppedTicks = 0;
+    };
+
+}
@@ -70,6 +70,6 @@ namespace utility {
 
 
 
-    std::string hexStr(u8 *data, u32 len);
+    std::string hexStr(const u8 *data, u32 len);
 
 }
\ No newline at end of file
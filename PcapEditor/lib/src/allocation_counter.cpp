@@ -0,0 +1,26 @@
+#include <allocation_counter.hpp>
+
+
+namespace {
+
+    thread_local u64 s_threadAllocationCount = 0;
+    thread_local u64 s_threadAllocationBytes = 0;
+
+}
+
+namespace PcapEditor::allocation {
+
+    u64 getThreadCount() {
+        return s_threadAllocationCount;
+    }
+
+    u64 getThreadBytes() {
+        return s_threadAllocationBytes;
+    }
+
+    void impl::countAllocation(std::size_t size) {
+        s_threadAllocationCount++;
+        s_threadAllocationBytes += size;
+    }
+
+}
@@ -5,4 +5,63 @@
 namespace PcapEditor
 {
 
+    void registerNodes() {
+        utility::add<NodeInteger>("hex.builtin.nodes.constants", "hex.builtin.nodes.constants.int");
+        utility::add<NodeFloat>("hex.builtin.nodes.constants", "hex.builtin.nodes.constants.float");
+        utility::add<NodeNullptr>("hex.builtin.nodes.constants", "hex.builtin.nodes.constants.nullptr");
+        utility::add<NodeBuffer>("hex.builtin.nodes.constants", "hex.builtin.nodes.constants.buffer");
+        utility::add<NodeString>("hex.builtin.nodes.constants", "hex.builtin.nodes.constants.string");
+        utility::add<NodeRGBA8>("hex.builtin.nodes.constants", "hex.builtin.nodes.constants.rgba8");
+        utility::add<NodeComment>("hex.builtin.nodes.constants", "hex.builtin.nodes.constants.comment");
+        
+
+        utility::add<NodeDisPlayStats>("hex.builtin.nodes.display", "hex.builtin.nodes.display.stats");
+
+        utility::add<NodeDisplayInteger>("hex.builtin.nodes.display", "hex.builtin.nodes.display.int");
+        utility::add<NodeDisplayFloat>("hex.builtin.nodes.display", "hex.builtin.nodes.display.float");
+        utility::add<NodeDisplayBuffer>("hex.builtin.nodes.display", "hex.builtin.nodes.display.buffer");
+        utility::add<NodeDisplayString>("hex.builtin.nodes.display", "hex.builtin.nodes.display.string");
+
+
+        utility::add<NodeCastIntegerToBuffer>("hex.builtin.nodes.casting", "hex.builtin.nodes.casting.int_to_buffer");
+        utility::add<NodeCastBufferToInteger>("hex.builtin.nodes.casting", "hex.builtin.nodes.casting.buffer_to_int");
+
+        utility::add<NodeArithmeticAdd>("hex.builtin.nodes.arithmetic", "hex.builtin.nodes.arithmetic.add");
+        utility::add<NodeArithmeticSubtract>("hex.builtin.nodes.arithmetic", "hex.builtin.nodes.arithmetic.sub");
+        utility::add<NodeArithmeticMultiply>("hex.builtin.nodes.arithmetic", "hex.builtin.nodes.arithmetic.mul");
+        utility::add<NodeArithmeticDivide>("hex.builtin.nodes.arithmetic", "hex.builtin.nodes.arithmetic.div");
+        utility::add<NodeArithmeticModulus>("hex.builtin.nodes.arithmetic", "hex.builtin.nodes.arithmetic.mod");
+
+        utility::add<NodeBufferCombine>("hex.builtin.nodes.buffer", "hex.builtin.nodes.buffer.combine");
+        utility::add<NodeBufferSlice>("hex.builtin.nodes.buffer", "hex.builtin.nodes.buffer.slice");
+        utility::add<NodeBufferRepeat>("hex.builtin.nodes.buffer", "hex.builtin.nodes.buffer.repeat");
+
+        utility::add<NodeIf>("hex.builtin.nodes.control_flow", "hex.builtin.nodes.control_flow.if");
+        utility::add<NodeEquals>("hex.builtin.nodes.control_flow", "hex.builtin.nodes.control_flow.equals");
+        utility::add<NodeNot>("hex.builtin.nodes.control_flow", "hex.builtin.nodes.control_flow.not");
+        utility::add<NodeGreaterThan>("hex.builtin.nodes.control_flow", "hex.builtin.nodes.control_flow.gt");
+        utility::add<NodeLessThan>("hex.builtin.nodes.control_flow", "hex.builtin.nodes.control_flow.lt");
+        utility::add<NodeBoolAND>("hex.builtin.nodes.control_flow", "hex.builtin.nodes.control_flow.and");
+        utility::add<NodeBoolOR>("hex.builtin.nodes.control_flow", "hex.builtin.nodes.control_flow.or");
+
+        utility::add<NodeBitwiseAND>("hex.builtin.nodes.bitwise", "hex.builtin.nodes.bitwise.and");
+        utility::add<NodeBitwiseOR>("hex.builtin.nodes.bitwise", "hex.builtin.nodes.bitwise.or");
+        utility::add<NodeBitwiseXOR>("hex.builtin.nodes.bitwise", "hex.builtin.nodes.bitwise.xor");
+        utility::add<NodeBitwiseNOT>("hex.builtin.nodes.bitwise", "hex.builtin.nodes.bitwise.not");
+
+        utility::add<NodeFilterOR>("hex.builtin.nodes.filter", "hex.builtin.nodes.filter.or");
+        
+        utility::add<NodePortFilter>("hex.builtin.nodes.filter", "hex.builtin.nodes.filter.portfilter");
+        utility::add<NodePcap>("hex.builtin.nodes.device", "hex.builtin.nodes.device.pcap");
+
+        utility::add<NodePacketFilter>("hex.builtin.nodes.stream", "hex.builtin.nodes.stream.filter");
+        utility::add<NodePacketPortFilter>("hex.builtin.nodes.stream", "hex.builtin.nodes.stream.port");
+        utility::add<NodePacketLengthFilter>("hex.builtin.nodes.stream", "hex.builtin.nodes.stream.length");
+        utility::add<NodePacketClassify>("hex.builtin.nodes.stream", "hex.builtin.nodes.stream.classify");
+        utility::add<NodePacketCount>("hex.builtin.nodes.stream", "hex.builtin.nodes.stream.count");
+        utility::add<NodePacketExtract>("hex.builtin.nodes.stream", "hex.builtin.nodes.stream.extract");
+
+
+    }
+
 } // namespace PcapEditor
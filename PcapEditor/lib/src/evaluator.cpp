@@ -0,0 +1,345 @@
+#include <evaluator.hpp>
+#include <pipeline.hpp>
+#include <provider.hpp>
+#include <utility.hpp>
+
+#include <cstdio>
+#include <iostream>
+#include <unordered_set>
+
+
+namespace PcapEditor {
+
+    Evaluator::Evaluator() : m_thread([this] { this->threadLoop(); }) {
+    }
+
+    Evaluator::~Evaluator() {
+        {
+            std::scoped_lock lock(this->m_commandMutex);
+            this->m_stop = true;
+        }
+        this->m_commandCondition.notify_one();
+
+        this->m_thread.join();
+    }
+
+    void Evaluator::post(std::function<void()> command) {
+        {
+            std::scoped_lock lock(this->m_commandMutex);
+            this->m_commands.push_back(std::move(command));
+        }
+        this->m_commandCondition.notify_one();
+    }
+
+    u64 Evaluator::setSnapshot(GraphSnapshot snapshot) {
+        const auto generation = ++this->m_snapshotCounter;
+
+        this->post([this, snapshot = std::move(snapshot), generation]() mutable {
+            this->applySnapshot(std::move(snapshot), generation);
+        });
+
+        return generation;
+    }
+
+    void Evaluator::requestEvaluation() {
+        this->post([this] { this->m_evaluationRequested = true; });
+    }
+
+    void Evaluator::setContinuous(bool continuous) {
+        this->post([this, continuous] {
+            if (continuous && !this->m_continuous)
+                this->m_ticks.start(TickScheduler::Clock::now());
+
+            this->m_continuous = continuous;
+        });
+    }
+
+    void Evaluator::setTickRate(double rate) {
+        this->post([this, rate] { this->m_ticks.setRate(rate); });
+    }
+
+    void Evaluator::setTickPolicy(TickScheduler::Policy policy) {
+        this->post([this, policy] { this->m_ticks.setPolicy(policy); });
+    }
+
+    bool Evaluator::fetchResult(EvaluationResult &result) {
+        std::scoped_lock lock(this->m_resultMutex);
+
+        if (this->m_result.evaluation == result.evaluation)
+            return false;
+
+        result = this->m_result;
+        return true;
+    }
+
+    void Evaluator::applySnapshot(GraphSnapshot snapshot, u64 generation) {
+        // Only end nodes that went away lose their overlay, the node itself may be freed once this returns
+        std::vector<Node *> removedEndNodes;
+        for (auto &[endNode, overlay] : this->m_dataOverlays) {
+            if (std::find(snapshot.endNodes.begin(), snapshot.endNodes.end(), endNode) == snapshot.endNodes.end())
+                removedEndNodes.push_back(endNode);
+        }
+
+        for (auto endNode : removedEndNodes)
+            this->deleteOverlay(endNode);
+
+        for (auto node : this->m_snapshot.nodes) {
+            for (auto &attribute : node->getAttributes())
+                attribute.setInputSource(nullptr);
+        }
+
+        this->m_snapshot = std::move(snapshot);
+        this->m_profiler.retain(this->m_snapshot.nodes);
+
+        for (auto &[input, output] : this->m_snapshot.connections)
+            input->setInputSource(output);
+
+        PacketOperatorNode::fuseChains(this->m_snapshot.nodes, this->m_snapshot.connections);
+        this->validate();
+        this->findFoldableNodes();
+
+        this->m_appliedSnapshot = generation;
+    }
+
+    void Evaluator::validate() {
+        enum class State { Visiting, Valid, Invalid };
+
+        std::unordered_map<Node *, State> states;
+        std::unordered_map<Node *, std::string> errors;
+
+        // A node is valid if all of its inputs are connected to valid nodes. Only the node causing the problem gets an error,
+        // the nodes downstream of it are just skipped.
+        std::function<bool(Node *)> check = [&](Node *node) {
+            if (auto state = states.find(node); state != states.end()) {
+                if (state->second == State::Visiting)
+                    errors.try_emplace(node, "Recursion detected!");
+
+                return state->second == State::Valid;
+            }
+
+            states[node] = State::Visiting;
+
+            bool valid = true;
+            for (auto &attribute : node->getAttributes()) {
+                if (attribute.getIOType() != Attribute::IOType::In)
+                    continue;
+
+                if (auto source = attribute.getInputSource(); source == nullptr) {
+                    errors.try_emplace(node, utility::format("Nothing connected to input '{0}'", attribute.getUnlocalizedName()));
+                    valid = false;
+                } else if (!check(source->getParentNode())) {
+                    valid = false;
+                }
+            }
+
+            if (errors.contains(node))
+                valid = false;
+
+            states[node] = valid ? State::Valid : State::Invalid;
+            return valid;
+        };
+
+        this->m_validEndNodes.clear();
+        for (auto endNode : this->m_snapshot.endNodes) {
+            if (check(endNode))
+                this->m_validEndNodes.push_back(endNode);
+            else
+                this->deleteOverlay(endNode);
+        }
+
+        this->m_validationErrors.clear();
+        for (auto &[node, message] : errors)
+            this->m_validationErrors.push_back({ node->getId(), std::move(message) });
+    }
+
+    void Evaluator::findFoldableNodes() {
+        enum class State { Visiting, Foldable, NotFoldable };
+
+        std::unordered_map<Node *, State> states;
+
+        std::function<bool(Node *)> check = [&](Node *node) {
+            if (auto state = states.find(node); state != states.end())
+                return state->second == State::Foldable;
+
+            states[node] = State::Visiting;
+
+            bool foldable = node->isConstant();
+            if (!foldable && node->isPure()) {
+                foldable = true;
+                for (auto &attribute : node->getAttributes()) {
+                    if (attribute.getIOType() != Attribute::IOType::In)
+                        continue;
+
+                    auto source = attribute.getInputSource();
+                    if (source == nullptr || !check(source->getParentNode()))
+                        foldable = false;
+                }
+            }
+
+            states[node] = foldable ? State::Foldable : State::NotFoldable;
+            return foldable;
+        };
+
+        // The topology changed, every constant subtree gets evaluated again once before it's folded
+        this->m_foldableNodes.clear();
+        this->m_foldableConsumers.clear();
+        this->m_constantVersions.clear();
+
+        for (auto node : this->m_snapshot.nodes) {
+            node->setFolded(false);
+
+            if (check(node))
+                this->m_foldableNodes.push_back(node);
+        }
+
+        for (auto &[input, output] : this->m_snapshot.connections) {
+            auto consumer = input->getParentNode();
+            if (states[consumer] == State::Foldable)
+                this->m_foldableConsumers[output->getParentNode()].push_back(consumer);
+        }
+    }
+
+    void Evaluator::unfold(Node *node) {
+        if (!node->isFolded())
+            return;
+
+        node->setFolded(false);
+
+        if (auto consumers = this->m_foldableConsumers.find(node); consumers != this->m_foldableConsumers.end()) {
+            for (auto consumer : consumers->second)
+                this->unfold(consumer);
+        }
+    }
+
+    void Evaluator::checkConstants() {
+        for (auto node : this->m_foldableNodes) {
+            if (!node->isConstant())
+                continue;
+
+            // Parameters edited in the UI unfold everything computed from them
+            const auto version = node->getParameterVersion();
+            if (auto &previous = this->m_constantVersions[node]; previous != version) {
+                previous = version;
+                this->unfold(node);
+            }
+        }
+    }
+
+    void Evaluator::deleteOverlay(Node *endNode) {
+        auto overlay = this->m_dataOverlays.find(endNode);
+        if (overlay == this->m_dataOverlays.end())
+            return;
+
+        for (auto data : overlay->second)
+            get()->deleteOverlay(data);
+        this->m_dataOverlays.erase(overlay);
+    }
+
+    void Evaluator::threadLoop() {
+        while (true) {
+            std::vector<std::function<void()>> commands;
+
+            {
+                std::unique_lock lock(this->m_commandMutex);
+                auto ready = [this] { return this->m_stop || !this->m_commands.empty(); };
+
+                if (this->m_continuous)
+                    this->m_commandCondition.wait_until(lock, this->m_ticks.getDeadline(), ready);
+                else if (!this->m_evaluationRequested)
+                    this->m_commandCondition.wait(lock, ready);
+
+                if (this->m_stop)
+                    return;
+
+                std::swap(commands, this->m_commands);
+            }
+
+            for (auto &command : commands)
+                command();
+
+            const auto now = TickScheduler::Clock::now();
+            const auto ticks = this->m_continuous ? this->m_ticks.advance(now) : 0;
+
+            if (ticks > 0) {
+                // The first evaluation also stands for the ticks that were dropped
+                const auto interval = std::chrono::duration<double>(this->m_ticks.getInterval()).count();
+
+                for (u32 i = 0; i < ticks; i++)
+                    this->evaluate(i == 0 ? interval * (1 + this->m_ticks.getLastDroppedTicks()) : interval);
+            } else if (this->m_evaluationRequested) {
+                this->evaluate(std::chrono::duration<double>(now - this->m_lastEvaluation).count());
+            }
+
+            if (ticks > 0 || this->m_evaluationRequested)
+                this->m_lastEvaluation = now;
+            this->m_evaluationRequested = false;
+        }
+    }
+
+    void Evaluator::evaluate(double tickInterval) {
+        Node::setTickInterval(tickInterval);
+
+        for (auto endNode : this->m_validEndNodes) {
+            auto &overlays = this->m_dataOverlays[endNode];
+            const auto count = endNode->getOverlayCount();
+            while (overlays.size() < count)
+                overlays.push_back(get()->newOverlay());
+            while (overlays.size() > count) {
+                get()->deleteOverlay(overlays.back());
+                overlays.pop_back();
+            }
+
+            endNode->setCurrentOverlays(overlays);
+        }
+
+        this->checkConstants();
+
+        std::vector<EvaluationError> errors = this->m_validationErrors;
+
+        try {
+            this->m_scheduler.evaluate(this->m_validEndNodes);
+        } catch (Node::NodeError &e) {
+            errors.push_back({ e.first->getId(), e.second });
+        } catch (std::runtime_error &e) {
+            std::printf("Node implementation bug! %s\n", e.what());
+        } catch (...) {
+            std::cout << "*******unknown error occurs!!!!********" << std::endl;
+        }
+
+        const auto &report = this->m_scheduler.getReport();
+        errors.insert(errors.end(), report.errors.begin(), report.errors.end());
+
+        // Drop the stale data of branches that failed or were skipped, the others keep theirs
+        for (auto endNode : this->m_validEndNodes) {
+            if (!endNode->isProcessed())
+                this->deleteOverlay(endNode);
+        }
+
+        std::unordered_set<u32> evaluatedNodes;
+        for (const auto &timing : report.timings)
+            evaluatedNodes.insert(timing.nodeId);
+
+        // Constant subtrees that made it through are reused as they are until one of their parameters changes
+        std::vector<u32> foldedNodes;
+        for (auto node : this->m_foldableNodes) {
+            if (node->isProcessed() && (node->isFolded() || evaluatedNodes.contains(node->getId()))) {
+                node->setFolded(true);
+                foldedNodes.push_back(node->getId());
+            }
+        }
+
+        this->m_profiler.record(report);
+
+        std::scoped_lock lock(this->m_resultMutex);
+        this->m_result.evaluation  = ++this->m_evaluationCounter;
+        this->m_result.errors      = std::move(errors);
+        this->m_result.report      = report;
+        this->m_result.profiler    = this->m_profiler;
+        this->m_result.foldedNodes = std::move(foldedNodes);
+
+        this->m_result.ticks           = this->m_ticks.getTicks();
+        this->m_result.missedDeadlines = this->m_ticks.getMissedDeadlines();
+        this->m_result.droppedTicks    = this->m_ticks.getDroppedTicks();
+    }
+
+}
@@ -0,0 +1,390 @@
+#include <graph_file.hpp>
+#include <node_group.hpp>
+#include <utility.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <nlohmann/json.hpp>
+
+
+namespace PcapEditor {
+
+    namespace {
+
+        static_assert(std::endian::native == std::endian::little, "The binary graph format is written in host byte order");
+
+        class Writer {
+        public:
+            explicit Writer(std::vector<u8> &data) : m_data(data) { }
+
+            template<class T>
+            void write(T value) {
+                const auto offset = this->m_data.size();
+                this->m_data.resize(offset + sizeof(T));
+                std::memcpy(this->m_data.data() + offset, &value, sizeof(T));
+            }
+
+            void writeBytes(std::span<const u8> bytes) {
+                this->m_data.insert(this->m_data.end(), bytes.begin(), bytes.end());
+            }
+
+        private:
+            std::vector<u8> &m_data;
+        };
+
+        class Reader {
+        public:
+            explicit Reader(std::span<const u8> data) : m_data(data) { }
+
+            template<class T>
+            T read() {
+                T value;
+                std::memcpy(&value, this->readBytes(sizeof(T)).data(), sizeof(T));
+                return value;
+            }
+
+            // A count of records taking at least recordSize bytes each, more than the rest of the file could hold is rejected
+            u32 readCount(size_t recordSize) {
+                const auto count = this->read<u32>();
+                if (count > (this->m_data.size() - this->m_offset) / recordSize)
+                    throw std::runtime_error("Graph file is truncated");
+
+                return count;
+            }
+
+            std::span<const u8> readBytes(size_t size) {
+                if (size > this->m_data.size() - this->m_offset)
+                    throw std::runtime_error("Graph file is truncated");
+
+                auto bytes = this->m_data.subspan(this->m_offset, size);
+                this->m_offset += size;
+                return bytes;
+            }
+
+        private:
+            std::span<const u8> m_data;
+            size_t m_offset = 0;
+        };
+
+        struct SavedLink {
+            u32 id, from, to;
+        };
+
+        // Groups aren't in the palette, their pins come from the members they load
+        const utility::impl::CreatorFunction CreateGroup = [] { return NodeGroup::create(); };
+
+        // Nodes created while loading, freed again unless the whole graph could be read
+        class LoadedGraph {
+        public:
+            LoadedGraph() {
+                for (const auto &entry : utility::getEntries()) {
+                    // Template instances are saved as plain groups
+                    if (!entry.name.empty() && entry.category != NodeGroup::TemplateCategory)
+                        this->m_creators.emplace(entry.name, &entry.creatorFunction);
+                }
+
+                this->m_creators.emplace(NodeGroup::UnlocalizedName, &CreateGroup);
+            }
+
+            ~LoadedGraph() {
+                for (auto node : this->m_nodes)
+                    delete node;
+            }
+
+            void reserve(size_t nodeCount, size_t attributeCount) {
+                this->m_nodes.reserve(nodeCount);
+                this->m_attributeCount = attributeCount;
+
+                this->m_nodeIds.reserve(nodeCount);
+                this->m_attributeIds.reserve(attributeCount);
+            }
+
+            void reserveLinks(size_t linkCount) {
+                this->m_links.reserve(linkCount);
+                this->m_linkIds.reserve(linkCount);
+            }
+
+            Node *createNode(std::string_view type) {
+                auto creator = this->m_creators.find(type);
+                if (creator == this->m_creators.end())
+                    throw std::runtime_error(utility::format("Unknown node type '{0}'", type));
+
+                auto node = (*creator->second)();
+                this->m_nodes.push_back(node);
+
+                return node;
+            }
+
+            // After the node loaded its parameters, some nodes only have their attributes then
+            template<class AttributeIds>
+            void setIds(Node *node, u32 id, size_t attributeCount, AttributeIds &&getAttributeId) {
+                auto &attributes = node->getAttributes();
+                if (attributes.size() != attributeCount)
+                    throw std::runtime_error(utility::format("Saved node {0} of type '{1}' has {2} attributes, the type has {3}", id, node->getUnlocalizedName(), attributeCount, attributes.size()));
+
+                if (!this->m_nodeIds.insert(id).second)
+                    throw std::runtime_error(utility::format("Graph contains node id {0} more than once", id));
+
+                node->setId(id);
+                for (u32 i = 0; i < attributes.size(); i++) {
+                    const u32 attributeId = getAttributeId(i);
+                    if (!this->m_attributeIds.insert(attributeId).second)
+                        throw std::runtime_error(utility::format("Graph contains attribute id {0} more than once", attributeId));
+
+                    attributes[i].setId(attributeId);
+                }
+
+                this->m_maxNodeId = std::max(this->m_maxNodeId, id);
+            }
+
+            void addLink(u32 id, u32 from, u32 to) {
+                if (!this->m_linkIds.insert(id).second)
+                    throw std::runtime_error(utility::format("Graph contains link id {0} more than once", id));
+
+                this->m_links.push_back({ id, from, to });
+                this->m_maxLinkId = std::max(this->m_maxLinkId, id);
+            }
+
+            // Hands the nodes over to the graph and restores the id counters past everything that was loaded
+            void commit(GraphRegistry &graph, u32 nodeCounter, u32 attributeCounter, u32 linkCounter) {
+                u32 maxAttributeId = 0;
+
+                graph.reserve(graph.getNodes().size() + this->m_nodes.size(), this->m_attributeCount, this->m_links.size());
+                for (auto node : this->m_nodes) {
+                    for (auto &attribute : node->getAttributes())
+                        maxAttributeId = std::max(maxAttributeId, attribute.getId());
+
+                    graph.addNode(node);
+                }
+                this->m_nodes.clear();
+
+                // Links the saved graph couldn't have contained are dropped
+                for (const auto &link : this->m_links)
+                    graph.addLink(link.id, link.from, link.to);
+
+                Node::setIdCounter(std::max(nodeCounter, this->m_maxNodeId + 1));
+                Attribute::setIdCounter(std::max(attributeCounter, maxAttributeId + 1));
+                Link::setIdCounter(std::max(linkCounter, this->m_maxLinkId + 1));
+            }
+
+        private:
+            std::unordered_map<std::string_view, const utility::impl::CreatorFunction *> m_creators;
+            std::vector<Node *> m_nodes;
+            std::vector<SavedLink> m_links;
+            // Ids seen so far, a file repeating one is rejected before anything reaches the graph
+            std::unordered_set<u32> m_nodeIds, m_attributeIds, m_linkIds;
+            size_t m_attributeCount = 0;
+            u32 m_maxNodeId = 0, m_maxLinkId = 0;
+        };
+
+        nlohmann::json storeNode(Node *node) {
+            nlohmann::json data;
+
+            // The evaluation thread may be processing the node
+            std::scoped_lock lock(node->getMutex());
+            node->store(data);
+
+            return data;
+        }
+
+    }
+
+    void GraphFile::storeJson(const GraphRegistry &graph, const Positions &positions, nlohmann::json &j) {
+        j = nlohmann::json::object();
+
+        j["version"]  = Version;
+        j["counters"] = { { "node", Node::getIdCounter() }, { "attribute", Attribute::getIdCounter() }, { "link", Link::getIdCounter() } };
+
+        auto &nodes = j["nodes"] = nlohmann::json::array();
+        for (auto node : graph.getNodes()) {
+            auto &output = nodes.emplace_back();
+
+            output["id"]   = node->getId();
+            output["type"] = node->getUnlocalizedName();
+            output["data"] = storeNode(node);
+
+            auto &attributes = output["attrs"] = nlohmann::json::array();
+            for (auto &attribute : node->getAttributes())
+                attributes.push_back(attribute.getId());
+
+            if (auto position = positions.find(node->getId()); position != positions.end())
+                output["pos"] = { { "x", position->second.x }, { "y", position->second.y } };
+        }
+
+        auto &links = j["links"] = nlohmann::json::array();
+        for (const auto &[id, link] : graph.getLinks())
+            links.push_back({ { "id", id }, { "from", link.getFromId() }, { "to", link.getToId() } });
+    }
+
+    void GraphFile::loadJson(const nlohmann::json &j, GraphRegistry &graph, Positions &positions) {
+        if (j.at("version").get<u32>() > Version)
+            throw std::runtime_error("Graph was saved by a newer version");
+
+        const auto &nodes = j.at("nodes");
+        const auto &links = j.at("links");
+
+        size_t attributeCount = 0;
+        for (const auto &input : nodes)
+            attributeCount += input.at("attrs").size();
+
+        LoadedGraph loaded;
+        loaded.reserve(nodes.size(), attributeCount);
+        loaded.reserveLinks(links.size());
+        positions.reserve(positions.size() + nodes.size());
+
+        for (const auto &input : nodes) {
+            const auto id          = input.at("id").get<u32>();
+            const auto &attributes = input.at("attrs");
+
+            auto node = loaded.createNode(input.at("type").get<std::string>());
+            if (auto data = input.at("data"); !data.is_null())
+                node->load(data);
+
+            loaded.setIds(node, id, attributes.size(), [&](u32 index) { return attributes[index].get<u32>(); });
+
+            if (auto position = input.find("pos"); position != input.end())
+                positions[id] = ImVec2(position->at("x").get<float>(), position->at("y").get<float>());
+        }
+
+        for (const auto &input : links)
+            loaded.addLink(input.at("id").get<u32>(), input.at("from").get<u32>(), input.at("to").get<u32>());
+
+        const auto &counters = j.at("counters");
+        loaded.commit(graph, counters.at("node").get<u32>(), counters.at("attribute").get<u32>(), counters.at("link").get<u32>());
+    }
+
+    std::vector<u8> GraphFile::storeBinary(const GraphRegistry &graph, const Positions &positions) {
+        std::vector<u8> data;
+        Writer writer(data);
+
+        writer.writeBytes(Magic);
+        writer.write<u32>(Version);
+        writer.write<u32>(Node::getIdCounter());
+        writer.write<u32>(Attribute::getIdCounter());
+        writer.write<u32>(Link::getIdCounter());
+
+        std::unordered_map<std::string_view, u16> typeIndices;
+        std::vector<std::string_view> types;
+        size_t attributeCount = 0;
+
+        for (auto node : graph.getNodes()) {
+            if (typeIndices.try_emplace(node->getUnlocalizedName(), types.size()).second)
+                types.push_back(node->getUnlocalizedName());
+
+            attributeCount += node->getAttributes().size();
+        }
+
+        writer.write<u32>(types.size());
+        for (auto type : types) {
+            writer.write<u16>(type.size());
+            writer.writeBytes({ reinterpret_cast<const u8 *>(type.data()), type.size() });
+        }
+
+        writer.write<u32>(graph.getNodes().size());
+        writer.write<u32>(attributeCount);
+        for (auto node : graph.getNodes()) {
+            const auto position = positions.find(node->getId());
+
+            writer.write<u32>(node->getId());
+            writer.write<u16>(typeIndices[node->getUnlocalizedName()]);
+            writer.write<float>(position != positions.end() ? position->second.x : 0.0F);
+            writer.write<float>(position != positions.end() ? position->second.y : 0.0F);
+
+            writer.write<u16>(node->getAttributes().size());
+            for (auto &attribute : node->getAttributes())
+                writer.write<u32>(attribute.getId());
+
+            if (auto parameters = storeNode(node); parameters.is_null()) {
+                writer.write<u32>(0);
+            } else {
+                const auto packed = nlohmann::json::to_msgpack(parameters);
+                writer.write<u32>(packed.size());
+                writer.writeBytes(packed);
+            }
+        }
+
+        writer.write<u32>(graph.getLinks().size());
+        for (const auto &[id, link] : graph.getLinks()) {
+            writer.write<u32>(id);
+            writer.write<u32>(link.getFromId());
+            writer.write<u32>(link.getToId());
+        }
+
+        return data;
+    }
+
+    void GraphFile::loadBinary(std::span<const u8> data, GraphRegistry &graph, Positions &positions) {
+        if (!isBinary(data))
+            throw std::runtime_error("Not a binary graph file");
+
+        Reader reader(data.subspan(Magic.size()));
+        if (reader.read<u32>() > Version)
+            throw std::runtime_error("Graph was saved by a newer version");
+
+        const auto nodeCounter      = reader.read<u32>();
+        const auto attributeCounter = reader.read<u32>();
+        const auto linkCounter      = reader.read<u32>();
+
+        // Each type is at least its u16 name length
+        std::vector<std::string_view> types(reader.readCount(sizeof(u16)));
+        for (auto &type : types) {
+            const auto name = reader.readBytes(reader.read<u16>());
+            type = { reinterpret_cast<const char *>(name.data()), name.size() };
+        }
+
+        // A node is at least its id, type, position, attribute and parameter sizes, an attribute is its u32 id
+        const auto nodeCount      = reader.readCount(sizeof(u32) + sizeof(u16) + 2 * sizeof(float) + sizeof(u16) + sizeof(u32));
+        const auto attributeCount = reader.readCount(sizeof(u32));
+
+        LoadedGraph loaded;
+        loaded.reserve(nodeCount, attributeCount);
+        positions.reserve(positions.size() + nodeCount);
+
+        for (u32 i = 0; i < nodeCount; i++) {
+            const auto id        = reader.read<u32>();
+            const auto typeIndex = reader.read<u16>();
+            const auto x         = reader.read<float>();
+            const auto y         = reader.read<float>();
+
+            if (typeIndex >= types.size())
+                throw std::runtime_error("Graph file references an undefined node type");
+
+            const auto attributeIds = reader.readBytes(reader.read<u16>() * sizeof(u32));
+
+            auto node = loaded.createNode(types[typeIndex]);
+            if (const auto parameters = reader.readBytes(reader.read<u32>()); !parameters.empty()) {
+                auto j = nlohmann::json::from_msgpack(parameters.begin(), parameters.end());
+                node->load(j);
+            }
+
+            loaded.setIds(node, id, attributeIds.size() / sizeof(u32), [&](u32 index) {
+                u32 attributeId;
+                std::memcpy(&attributeId, attributeIds.data() + index * sizeof(u32), sizeof(u32));
+                return attributeId;
+            });
+
+            positions[id] = ImVec2(x, y);
+        }
+
+        const auto linkCount = reader.readCount(3 * sizeof(u32));
+        loaded.reserveLinks(linkCount);
+        for (u32 i = 0; i < linkCount; i++) {
+            const auto id   = reader.read<u32>();
+            const auto from = reader.read<u32>();
+            loaded.addLink(id, from, reader.read<u32>());
+        }
+
+        loaded.commit(graph, nodeCounter, attributeCounter, linkCounter);
+    }
+
+    bool GraphFile::isBinary(std::span<const u8> data) {
+        return data.size() >= Magic.size() && std::equal(Magic.begin(), Magic.end(), data.begin());
+    }
+
+}
@@ -0,0 +1,136 @@
+#include <graph_registry.hpp>
+
+
+namespace PcapEditor {
+
+    void GraphRegistry::addNode(Node *node) {
+        for (auto &attribute : node->getAttributes())
+            this->m_attributes[attribute.getId()] = &attribute;
+
+        NodeEntry entry = { this->m_nodes.size(), NoIndex };
+        this->m_nodes.push_back(node);
+
+        if (node->isEndNode()) {
+            entry.endIndex = this->m_endNodes.size();
+            this->m_endNodes.push_back(node);
+        }
+
+        this->m_nodeEntries[node->getId()] = entry;
+    }
+
+    void GraphRegistry::reserve(size_t nodeCount, size_t attributeCount, size_t linkCount) {
+        this->m_nodes.reserve(nodeCount);
+        this->m_nodeEntries.reserve(nodeCount);
+        this->m_attributes.reserve(attributeCount);
+        this->m_links.reserve(linkCount);
+    }
+
+    std::vector<Node *> GraphRegistry::eraseNodes(std::span<const int> ids) {
+        std::vector<Node *> erased;
+        erased.reserve(ids.size());
+
+        for (const int id : ids) {
+            auto entry = this->m_nodeEntries.find(id);
+            if (entry == this->m_nodeEntries.end())
+                continue;
+
+            auto node = this->m_nodes[entry->second.index];
+
+            for (auto &attribute : node->getAttributes()) {
+                // Copy the ids, erasing a link modifies the map
+                std::vector<u32> linkIds;
+                for (auto &[linkId, connectedAttribute] : attribute.getConnectedAttributes())
+                    linkIds.push_back(linkId);
+
+                for (auto linkId : linkIds)
+                    this->eraseLink(linkId);
+
+                this->m_attributes.erase(attribute.getId());
+            }
+
+            if (entry->second.endIndex != NoIndex)
+                this->removeAt(this->m_endNodes, entry->second.endIndex, &NodeEntry::endIndex);
+            this->removeAt(this->m_nodes, entry->second.index, &NodeEntry::index);
+
+            this->m_nodeEntries.erase(entry);
+            erased.push_back(node);
+        }
+
+        return erased;
+    }
+
+    void GraphRegistry::removeAt(std::vector<Node *> &nodes, size_t index, size_t NodeEntry::*member) {
+        if (index != nodes.size() - 1) {
+            nodes[index] = nodes.back();
+            this->m_nodeEntries[nodes[index]->getId()].*member = index;
+        }
+
+        nodes.pop_back();
+    }
+
+    const Link *GraphRegistry::addLink(u32 from, u32 to) {
+        return this->addLink(0, from, to);
+    }
+
+    const Link *GraphRegistry::addLink(u32 id, u32 from, u32 to) {
+        auto fromAttribute = this->getAttribute(from);
+        auto toAttribute   = this->getAttribute(to);
+
+        if (fromAttribute == nullptr || toAttribute == nullptr)
+            return nullptr;
+
+        if (fromAttribute->getType() != toAttribute->getType())
+            return nullptr;
+
+        if (fromAttribute->getIOType() == toAttribute->getIOType())
+            return nullptr;
+
+        if (!toAttribute->getConnectedAttributes().empty())
+            return nullptr;
+
+        Link link(from, to);
+        if (id != 0)
+            link.setID(id);
+
+        if (this->m_links.contains(link.getId()))
+            return nullptr;
+
+        fromAttribute->addConnectedAttribute(link.getId(), toAttribute);
+        toAttribute->addConnectedAttribute(link.getId(), fromAttribute);
+
+        return &this->m_links.emplace(link.getId(), link).first->second;
+    }
+
+    bool GraphRegistry::eraseLink(u32 id) {
+        auto link = this->m_links.find(id);
+        if (link == this->m_links.end())
+            return false;
+
+        for (auto attributeId : { link->second.getFromId(), link->second.getToId() }) {
+            if (auto attribute = this->getAttribute(attributeId); attribute != nullptr)
+                attribute->removeConnectedAttribute(id);
+        }
+
+        this->m_links.erase(link);
+        return true;
+    }
+
+    Node *GraphRegistry::getNode(u32 id) const {
+        auto entry = this->m_nodeEntries.find(id);
+
+        return entry == this->m_nodeEntries.end() ? nullptr : this->m_nodes[entry->second.index];
+    }
+
+    Attribute *GraphRegistry::getAttribute(u32 id) const {
+        auto attribute = this->m_attributes.find(id);
+
+        return attribute == this->m_attributes.end() ? nullptr : attribute->second;
+    }
+
+    const Link *GraphRegistry::getLink(u32 id) const {
+        auto link = this->m_links.find(id);
+
+        return link == this->m_links.end() ? nullptr : &link->second;
+    }
+
+}
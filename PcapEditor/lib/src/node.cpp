@@ -4,13 +4,41 @@
 namespace PcapEditor{
 
     u32 Node::s_idCounter = 1;
+    double Node::s_tickInterval = 0;
 
-    Node::Node(std::string unlocalizedTitle, std::vector<Attribute> attributes) : m_id(Node::s_idCounter++), m_unlocalizedTitle(std::move(unlocalizedTitle)), m_attributes(std::move(attributes)) {
+    Node::Node(std::string unlocalizedTitle, std::initializer_list<Attribute> attributes) : m_id(Node::s_idCounter++), m_unlocalizedTitle(std::move(unlocalizedTitle)), m_attributes(attributes) {
         for (auto &attr : this->m_attributes)
             attr.setParentNode(this);
     }
 
-    std::vector<u8> Node::getBufferOnInput(u32 index) {
+    void Node::renewIds() {
+        this->m_id = Node::s_idCounter++;
+
+        for (auto &attribute : this->m_attributes)
+            attribute.setId(Attribute::s_idCounter++);
+    }
+
+    bool Node::isEndNode() {
+        bool hasInput = false, hasOutput = false;
+
+        for (auto &attribute : this->m_attributes) {
+            if (attribute.getIOType() == Attribute::IOType::In)
+                hasInput = true;
+            else
+                hasOutput = true;
+        }
+
+        return hasInput && !hasOutput;
+    }
+
+    void Node::setAttributes(Attributes attributes) {
+        this->m_attributes = std::move(attributes);
+
+        for (auto &attribute : this->m_attributes)
+            attribute.setParentNode(this);
+    }
+
+    SharedBuffer Node::getBufferOnInput(u32 index) {
         auto attribute = this->getConnectedInputAttribute(index);
 
         if (attribute == nullptr)
@@ -20,14 +48,18 @@ namespace PcapEditor{
             throw std::runtime_error("Tried to read buffer from non-buffer attribute");
 
         markInputProcessed(index);
-        attribute->getParentNode()->process();
+        this->processInput(attribute);
 
         auto &outputData = attribute->getOutputData();
 
-        if (!outputData.has_value())
+        if (!outputData.hasValue())
             throw std::runtime_error("No data available at connected attribute");
 
-        return outputData.value();
+        if (outputData.getKind() == OutputSlot::Kind::Buffer)
+            return outputData.getBuffer();
+
+        auto bytes = outputData.getBytes();
+        return std::vector<u8>(bytes.begin(), bytes.end());
     }
     std::string Node::getStringOnInput(u32 index) {
         auto attribute = this->getConnectedInputAttribute(index);
@@ -39,14 +71,15 @@ namespace PcapEditor{
             throw std::runtime_error("Tried to read buffer from non-buffer attribute");
 
         markInputProcessed(index);
-        attribute->getParentNode()->process();
+        this->processInput(attribute);
 
         auto &outputData = attribute->getOutputData();
 
-        if (!outputData.has_value())
+        if (!outputData.hasValue())
             throw std::runtime_error("No data available at connected attribute");
 
-        return std::string(outputData.value().begin(),outputData.value().end() );
+        auto bytes = outputData.getBytes();
+        return std::string(bytes.begin(), bytes.end());
     }
 
     u64 Node::getIntegerOnInput(u32 index) {
@@ -59,17 +92,23 @@ namespace PcapEditor{
             throw std::runtime_error("Tried to read integer from non-integer attribute");
 
         markInputProcessed(index);
-        attribute->getParentNode()->process();
+        this->processInput(attribute);
 
         auto &outputData = attribute->getOutputData();
 
-        if (!outputData.has_value())
+        if (!outputData.hasValue())
             throw std::runtime_error("No data available at connected attribute");
 
-        if (outputData->size() < sizeof(u64))
+        if (outputData.getKind() == OutputSlot::Kind::Integer)
+            return outputData.getInteger();
+
+        auto bytes = outputData.getBytes();
+        if (bytes.size() < sizeof(u64))
             throw std::runtime_error("Not enough data provided for integer");
 
-        return *reinterpret_cast<u64 *>(outputData->data());
+        u64 integer;
+        std::memcpy(&integer, bytes.data(), sizeof(u64));
+        return integer;
     }
 
     float Node::getFloatOnInput(u32 index) {
@@ -82,17 +121,23 @@ namespace PcapEditor{
             throw std::runtime_error("Tried to read float from non-float attribute");
 
         markInputProcessed(index);
-        attribute->getParentNode()->process();
+        this->processInput(attribute);
 
         auto &outputData = attribute->getOutputData();
 
-        if (!outputData.has_value())
+        if (!outputData.hasValue())
             throw std::runtime_error("No data available at connected attribute");
 
-        if (outputData->size() < sizeof(float))
+        if (outputData.getKind() == OutputSlot::Kind::Float)
+            return outputData.getFloat();
+
+        auto bytes = outputData.getBytes();
+        if (bytes.size() < sizeof(float))
             throw std::runtime_error("Not enough data provided for float");
 
-        return *reinterpret_cast<float *>(outputData->data());
+        float floatingPoint;
+        std::memcpy(&floatingPoint, bytes.data(), sizeof(float));
+        return floatingPoint;
     }
 
     // pcpp::GeneralFilter* Node::getFilterOnInput(u32 index) {
@@ -136,7 +181,7 @@ namespace PcapEditor{
     
     
 
-    void Node::setBufferOnOutput(u32 index, std::vector<u8> data) {
+    void Node::setBufferOnOutput(u32 index, SharedBuffer data) {
         if (index >= this->getAttributes().size())
             throw std::runtime_error("Attribute index out of bounds!");
 
@@ -145,7 +190,7 @@ namespace PcapEditor{
         if (attribute.getIOType() != Attribute::IOType::Out)
             throw std::runtime_error("Tried to set output data of an input attribute!");
 
-        attribute.getOutputData() = data;
+        attribute.getOutputData().setBuffer(std::move(data));
     }
     void Node::setStringOnOutput(u32 index, std::string data) {
         if (index >= this->getAttributes().size())
@@ -156,9 +201,7 @@ namespace PcapEditor{
         if (attribute.getIOType() != Attribute::IOType::Out)
             throw std::runtime_error("Tried to set output data of an input attribute!");
         
-        std::vector<u8> buffer(data.size() + 1, 0);
-        std::memcpy(buffer.data(), data.data(), data.size()+1);
-        attribute.getOutputData() = buffer;
+        attribute.getOutputData().setString(data);
     }
 
     void Node::setIntegerOnOutput(u32 index, u64 integer) {
@@ -170,10 +213,7 @@ namespace PcapEditor{
         if (attribute.getIOType() != Attribute::IOType::Out)
             throw std::runtime_error("Tried to set output data of an input attribute!");
 
-        std::vector<u8> buffer(sizeof(u64), 0);
-        std::memcpy(buffer.data(), &integer, sizeof(u64));
-
-        attribute.getOutputData() = buffer;
+        attribute.getOutputData().setInteger(integer);
     }
 
     void Node::setFloatOnOutput(u32 index, float floatingPoint) {
@@ -185,10 +225,7 @@ namespace PcapEditor{
         if (attribute.getIOType() != Attribute::IOType::Out)
             throw std::runtime_error("Tried to set output data of an input attribute!");
 
-        std::vector<u8> buffer(sizeof(float), 0);
-        std::memcpy(buffer.data(), &floatingPoint, sizeof(float));
-
-        attribute.getOutputData() = buffer;
+        attribute.getOutputData().setFloat(floatingPoint);
     }
 
     // void Node::setFilterOnOutput(u32 index, pcpp::GeneralFilter* filter) {
@@ -220,12 +257,12 @@ namespace PcapEditor{
     //     attribute.getOutputData() = buffer;
     // }
 
-    void Node::setOverlayData(u64 address, const std::vector<u8> &data) {
+    void Node::setOverlayData(u64 address, SharedBuffer data) {
         if (this->m_overlay == nullptr)
             throw std::runtime_error("Tried setting overlay data on a node that's not the end of a chain!");
 
         this->m_overlay->setAddress(address);
-        this->m_overlay->getData() = data;
+        this->m_overlay->getData() = std::move(data);
     }
 
 }
\ No newline at end of file
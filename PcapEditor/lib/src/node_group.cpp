@@ -0,0 +1,417 @@
+#include <node_group.hpp>
+#include <pipeline.hpp>
+#include <utility.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <nlohmann/json.hpp>
+
+
+namespace PcapEditor {
+
+    namespace {
+
+        // Members are created like the palette creates nodes. Groups aren't in the palette, their pins come from what they load.
+        Node *createMember(std::string_view type) {
+            if (type == NodeGroup::UnlocalizedName)
+                return NodeGroup::create();
+
+            for (const auto &entry : utility::getEntries()) {
+                if (entry.name == type && entry.category != NodeGroup::TemplateCategory)
+                    return entry.creatorFunction();
+            }
+
+            throw std::runtime_error(utility::format("Unknown node type '{0}'", type));
+        }
+
+    }
+
+    NodeGroup::NodeGroup() : Node("hex.builtin.nodes.group.header", {}) {
+        this->m_name.resize(0xFF, 0x00);
+    }
+
+    NodeGroup::~NodeGroup() {
+        for (auto &member : this->m_members)
+            delete member.node;
+    }
+
+    NodeGroup *NodeGroup::create() {
+        auto group = new NodeGroup();
+        group->setUnlocalizedName(std::string(UnlocalizedName));
+
+        return group;
+    }
+
+    NodeGroup *NodeGroup::collapse(GraphRegistry &graph, std::span<const int> ids, std::span<const ImVec2> positions, ImVec2 &position) {
+        auto group = NodeGroup::create();
+
+        std::unordered_set<Node *> members;
+        position = ImVec2(FLT_MAX, FLT_MAX);
+        for (u32 i = 0; i < ids.size(); i++) {
+            auto node = graph.getNode(ids[i]);
+            if (node == nullptr || !members.insert(node).second)
+                continue;
+
+            group->m_members.push_back({ node, positions[i] });
+            position = ImVec2(std::min(position.x, positions[i].x), std::min(position.y, positions[i].y));
+        }
+
+        for (auto &member : group->m_members)
+            member.offset = ImVec2(member.offset.x - position.x, member.offset.y - position.y);
+
+        // Links crossing the boundary by the member attribute they end at, and the attribute at their other end
+        std::vector<std::pair<Attribute *, u32>> boundary;
+        std::unordered_set<Attribute *> crossing, fedInside, usedInside;
+
+        for (auto &member : group->m_members) {
+            for (auto &attribute : member.node->getAttributes()) {
+                for (auto &[linkId, other] : attribute.getConnectedAttributes()) {
+                    if (!members.contains(other->getParentNode())) {
+                        boundary.emplace_back(&attribute, other->getId());
+                        crossing.insert(&attribute);
+                    } else if (attribute.getIOType() == Attribute::IOType::In) {
+                        group->m_links.push_back({ other, &attribute });
+                        fedInside.insert(&attribute);
+                        usedInside.insert(other);
+                    }
+                }
+            }
+        }
+
+        for (auto &member : group->m_members) {
+            for (auto &attribute : member.node->getAttributes()) {
+                const bool exposed = attribute.getIOType() == Attribute::IOType::In ? !fedInside.contains(&attribute) : crossing.contains(&attribute) || !usedInside.contains(&attribute);
+
+                if (exposed)
+                    group->m_pinTargets.push_back(&attribute);
+            }
+        }
+
+        group->buildPins();
+
+        std::unordered_map<Attribute *, u32> pinIds;
+        for (u32 i = 0; i < group->m_pinTargets.size(); i++)
+            pinIds[group->m_pinTargets[i]] = group->getAttributes()[i].getId();
+
+        std::vector<int> memberIds;
+        for (auto &member : group->m_members)
+            memberIds.push_back(member.node->getId());
+
+        // The members belong to the group now
+        graph.eraseNodes(memberIds);
+        graph.addNode(group);
+
+        for (auto [attribute, otherId] : boundary) {
+            if (attribute->getIOType() == Attribute::IOType::In)
+                graph.addLink(otherId, pinIds[attribute]);
+            else
+                graph.addLink(pinIds[attribute], otherId);
+        }
+
+        return group;
+    }
+
+    std::vector<NodeGroup::Member> NodeGroup::expand(GraphRegistry &graph) {
+        std::vector<std::pair<Attribute *, u32>> boundary;
+
+        auto &pins = this->getAttributes();
+        for (u32 i = 0; i < pins.size(); i++) {
+            for (auto &[linkId, other] : pins[i].getConnectedAttributes())
+                boundary.emplace_back(this->m_pinTargets[i], other->getId());
+        }
+
+        std::vector<Member> members;
+        std::vector<InnerLink> links;
+        {
+            // The evaluation thread may be running the group
+            std::scoped_lock lock(this->getMutex());
+
+            members = std::move(this->m_members);
+            links   = std::move(this->m_links);
+            this->m_members.clear();
+            this->m_links.clear();
+            this->m_pinTargets.clear();
+
+            // The group set these, the evaluator sets them again from its next snapshot
+            for (auto &member : members) {
+                for (auto &attribute : member.node->getAttributes())
+                    attribute.setInputSource(nullptr);
+            }
+        }
+
+        const std::array<int, 1> ids = { int(this->getId()) };
+        graph.eraseNodes(ids);
+
+        for (auto &member : members) {
+            member.node->renewIds();
+            graph.addNode(member.node);
+        }
+
+        for (auto &link : links)
+            graph.addLink(link.from->getId(), link.to->getId());
+
+        for (auto [attribute, otherId] : boundary) {
+            if (attribute->getIOType() == Attribute::IOType::In)
+                graph.addLink(otherId, attribute->getId());
+            else
+                graph.addLink(attribute->getId(), otherId);
+        }
+
+        return members;
+    }
+
+    void NodeGroup::addTemplate() {
+        const std::string name = this->m_name[0] != 0x00 ? this->m_name.c_str() : this->getUnlocalizedTitle();
+
+        nlohmann::json definition;
+        {
+            std::scoped_lock lock(this->getMutex());
+            this->store(definition);
+        }
+
+        utility::impl::add({ std::string(TemplateCategory), name, [definition]() -> Node * {
+                                auto group = NodeGroup::create();
+                                auto data  = definition;
+
+                                try {
+                                    group->load(data);
+                                } catch (...) {
+                                    delete group;
+                                    throw;
+                                }
+
+                                return group;
+                            } });
+    }
+
+    void NodeGroup::drawNode() {
+        ImGui::PushItemWidth(150);
+        ImGui::InputTextWithHint("##name", "hex.builtin.nodes.group.name", this->m_name.data(), this->m_name.size() - 1);
+        ImGui::PopItemWidth();
+
+        ImGui::TextDisabled("%zu nodes", this->m_members.size());
+    }
+
+    void NodeGroup::process() {
+        if (this->m_members.empty())
+            throwNodeError("Group was expanded");
+
+        if (!this->m_wired)
+            this->wireMembers();
+
+        auto &pins = this->getAttributes();
+        for (u32 i = 0; i < pins.size(); i++) {
+            if (pins[i].getIOType() == Attribute::IOType::In)
+                this->m_pinTargets[i]->setInputSource(pins[i].getInputSource());
+        }
+
+        for (auto &member : this->m_members) {
+            member.node->resetProcessedInputs();
+            member.node->resetOutputData();
+        }
+
+        for (auto &member : this->m_members) {
+            // Pulled already by a member running earlier
+            if (member.node->isProcessed())
+                continue;
+
+            try {
+                member.node->process();
+            } catch (NodeError &e) {
+                throwNodeError(utility::format("{0}: {1}", e.first->getUnlocalizedTitle(), e.second));
+            }
+
+            member.node->setProcessed();
+        }
+
+        for (u32 i = 0; i < pins.size(); i++) {
+            if (pins[i].getIOType() == Attribute::IOType::Out)
+                pins[i].getOutputData() = this->m_pinTargets[i]->getOutputData();
+        }
+    }
+
+    bool NodeGroup::isEndNode() {
+        return Node::isEndNode() || !this->m_endMembers.empty();
+    }
+
+    u32 NodeGroup::getOverlayCount() {
+        u32 count = 0;
+        for (auto member : this->m_endMembers)
+            count += member->getOverlayCount();
+
+        return count;
+    }
+
+    void NodeGroup::setCurrentOverlays(std::span<Overlay *const> overlays) {
+        // Every end member writes its own overlay, the same as outside of the group
+        for (auto member : this->m_endMembers) {
+            const auto count = member->getOverlayCount();
+            member->setCurrentOverlays(overlays.first(count));
+            overlays = overlays.subspan(count);
+        }
+    }
+
+    void NodeGroup::store(nlohmann::json &j) {
+        j = nlohmann::json::object();
+
+        j["name"] = this->m_name.c_str();
+
+        std::unordered_map<Node *, u32> indices;
+        auto &nodes = j["nodes"] = nlohmann::json::array();
+        for (auto &member : this->m_members) {
+            indices[member.node] = nodes.size();
+
+            nlohmann::json data;
+            member.node->store(data);
+            nodes.push_back({ { "type", member.node->getUnlocalizedName() }, { "data", std::move(data) }, { "x", member.offset.x }, { "y", member.offset.y } });
+        }
+
+        // Attributes are referred to by node and attribute index, load hands out new ids
+        const auto locate = [&](Attribute *attribute) {
+            auto node = attribute->getParentNode();
+            return nlohmann::json::array({ indices[node], u32(attribute - node->getAttributes().data()) });
+        };
+
+        auto &links = j["links"] = nlohmann::json::array();
+        for (auto &link : this->m_links)
+            links.push_back({ locate(link.from), locate(link.to) });
+
+        auto &pins = j["pins"] = nlohmann::json::array();
+        for (auto target : this->m_pinTargets)
+            pins.push_back(locate(target));
+    }
+
+    void NodeGroup::load(nlohmann::json &j) {
+        this->m_name = j.at("name").get<std::string>();
+        this->m_name.resize(0xFF, 0x00);
+
+        for (const auto &input : j.at("nodes")) {
+            auto node = createMember(input.at("type").get<std::string>());
+            this->m_members.push_back({ node, ImVec2(input.at("x").get<float>(), input.at("y").get<float>()) });
+
+            if (auto data = input.at("data"); !data.is_null())
+                node->load(data);
+        }
+
+        const auto locate = [this](const nlohmann::json &location) {
+            const auto node      = location.at(0).get<u32>();
+            const auto attribute = location.at(1).get<u32>();
+
+            if (node >= this->m_members.size() || attribute >= this->m_members[node].node->getAttributes().size())
+                throw std::runtime_error("Group refers to an attribute its members don't have");
+
+            return &this->m_members[node].node->getAttributes()[attribute];
+        };
+
+        for (const auto &link : j.at("links"))
+            this->m_links.push_back({ locate(link.at(0)), locate(link.at(1)) });
+
+        for (const auto &pin : j.at("pins"))
+            this->m_pinTargets.push_back(locate(pin));
+
+        this->buildPins();
+    }
+
+    void NodeGroup::buildPins() {
+        Attributes attributes;
+        attributes.reserve(this->m_pinTargets.size());
+        for (auto target : this->m_pinTargets)
+            attributes.emplace_back(target->getIOType(), target->getType(), target->getUnlocalizedName());
+
+        const bool hasInputs = std::any_of(attributes.begin(), attributes.end(), [](const Attribute &pin) { return pin.getIOType() == Attribute::IOType::In; });
+
+        // Members can't be edited while collapsed, so constants inside never change
+        this->m_threadSafe = true;
+        this->m_pure       = true;
+        this->m_endMembers.clear();
+        for (auto &member : this->m_members) {
+            this->m_threadSafe &= member.node->isThreadSafe();
+            this->m_pure &= member.node->isPure() || member.node->isConstant();
+
+            if (member.node->isEndNode())
+                this->m_endMembers.push_back(member.node);
+        }
+        this->m_constant = this->m_pure && !hasInputs;
+
+        this->setAttributes(std::move(attributes));
+        this->sortMembers();
+        this->m_wired = false;
+    }
+
+    void NodeGroup::sortMembers() {
+        std::unordered_map<Node *, u32> indices;
+        for (u32 i = 0; i < this->m_members.size(); i++)
+            indices[this->m_members[i].node] = i;
+
+        std::vector<u32> remainingInputs(this->m_members.size(), 0);
+        std::vector<std::vector<u32>> dependents(this->m_members.size());
+        for (auto &link : this->m_links) {
+            const auto to = indices[link.to->getParentNode()];
+
+            dependents[indices[link.from->getParentNode()]].push_back(to);
+            remainingInputs[to]++;
+        }
+
+        std::vector<u32> ready;
+        for (u32 i = 0; i < this->m_members.size(); i++) {
+            if (remainingInputs[i] == 0)
+                ready.push_back(i);
+        }
+
+        std::vector<Member> sorted;
+        sorted.reserve(this->m_members.size());
+        while (!ready.empty()) {
+            const auto index = ready.back();
+            ready.pop_back();
+
+            sorted.push_back(this->m_members[index]);
+            for (auto dependent : dependents[index]) {
+                if (--remainingInputs[dependent] == 0)
+                    ready.push_back(dependent);
+            }
+        }
+
+        // Members on a cycle go last, running them reports the recursion
+        for (u32 i = 0; i < this->m_members.size(); i++) {
+            if (remainingInputs[i] > 0)
+                sorted.push_back(this->m_members[i]);
+        }
+
+        this->m_members = std::move(sorted);
+    }
+
+    void NodeGroup::wireMembers() {
+        std::vector<Node *> nodes;
+        for (auto &member : this->m_members) {
+            nodes.push_back(member.node);
+
+            // Folded before they were grouped, the group folds as a whole now
+            member.node->setFolded(false);
+            for (auto &attribute : member.node->getAttributes())
+                attribute.setInputSource(nullptr);
+        }
+
+        std::vector<std::pair<Attribute *, Attribute *>> connections;
+        for (auto &link : this->m_links) {
+            link.to->setInputSource(link.from);
+            connections.emplace_back(link.to, link.from);
+        }
+
+        // Outputs leaving the group are consumers as well, a fused chain must still produce them
+        auto &pins = this->getAttributes();
+        for (u32 i = 0; i < pins.size(); i++) {
+            if (pins[i].getIOType() == Attribute::IOType::Out)
+                connections.emplace_back(&pins[i], this->m_pinTargets[i]);
+        }
+
+        PacketOperatorNode::fuseChains(nodes, connections);
+
+        this->m_wired = true;
+    }
+
+}
@@ -0,0 +1,406 @@
+#include <packet_stream.hpp>
+
+#include <algorithm>
+#include <initializer_list>
+
+
+namespace PcapEditor {
+
+    namespace {
+
+        constexpr u16 EtherTypeIPv4 = 0x0800, EtherTypeIPv6 = 0x86DD, EtherTypeARP = 0x0806, EtherTypeVLAN = 0x8100, EtherTypeQinQ = 0x88A8;
+        constexpr u8 IpProtocolICMP = 1, IpProtocolTCP = 6, IpProtocolUDP = 17, IpProtocolICMPv6 = 58;
+        constexpr u64 IPv4MappedPrefix = 0xFFFF'0000'0000ULL;
+
+        u16 readU16(const u8 *data) {
+            return u16(data[0]) << 8 | data[1];
+        }
+
+        u32 readU32(const u8 *data) {
+            return u32(readU16(data)) << 16 | readU16(data + 2);
+        }
+
+        u64 readU64(const u8 *data) {
+            u64 value = 0;
+            for (u32 i = 0; i < 8; i++)
+                value = value << 8 | data[i];
+
+            return value;
+        }
+
+        // Layers starting past what the offset columns can hold are stored as missing
+        u16 toOffset(size_t offset) {
+            return offset < PacketBatch::NoOffset ? u16(offset) : PacketBatch::NoOffset;
+        }
+
+        struct ParsedHeaders {
+            u16 l3Offset = PacketBatch::NoOffset, l4Offset = PacketBatch::NoOffset;
+            pcpp::ProtocolType protocols = pcpp::UnknownProtocol;
+            PacketAddress srcAddress, dstAddress;
+            u16 srcPort = 0, dstPort = 0;
+            u8 ipProtocol = 0;
+            u32 payloadOffset = 0, payloadLength = 0;
+        };
+
+        // Same well-known ports pcpp uses to decide which application layer to parse
+        pcpp::ProtocolType classifyApplication(u16 srcPort, u16 dstPort, std::span<const u8> payload) {
+            auto isPort = [&](std::initializer_list<u16> ports) {
+                return std::any_of(ports.begin(), ports.end(), [&](u16 port) { return port == srcPort || port == dstPort; });
+            };
+
+            if (isPort({ 53, 5353, 5355 }))
+                return pcpp::DNS;
+            if (!payload.empty() && isPort({ 80, 8080 }))
+                return pcpp::HTTP;
+            if (!payload.empty() && payload[0] >= 20 && payload[0] <= 23 && isPort({ 443, 261, 448, 465, 563, 614, 636, 989, 990, 992, 993, 994, 995 }))
+                return pcpp::SSL;
+
+            return pcpp::UnknownProtocol;
+        }
+
+        void parseL4(std::span<const u8> data, size_t offset, ParsedHeaders &headers) {
+            headers.l4Offset = toOffset(offset);
+
+            switch (headers.ipProtocol) {
+                case IpProtocolTCP:
+                    if (data.size() < offset + 20)
+                        return;
+
+                    headers.protocols |= pcpp::TCP;
+                    headers.payloadOffset = u32(std::min(data.size(), offset + (data[offset + 12] >> 4) * 4));
+                    break;
+                case IpProtocolUDP:
+                    if (data.size() < offset + 8)
+                        return;
+
+                    headers.protocols |= pcpp::UDP;
+                    headers.payloadOffset = u32(offset + 8);
+                    break;
+                case IpProtocolICMP:
+                case IpProtocolICMPv6:
+                    headers.protocols |= pcpp::ICMP;
+                    headers.payloadOffset = u32(std::min(data.size(), offset + 8));
+                    headers.payloadLength = u32(data.size() - headers.payloadOffset);
+                    return;
+                default:
+                    headers.payloadOffset = u32(offset);
+                    headers.payloadLength = u32(data.size() - offset);
+                    return;
+            }
+
+            headers.srcPort       = readU16(&data[offset]);
+            headers.dstPort       = readU16(&data[offset + 2]);
+            headers.payloadLength = u32(data.size() - headers.payloadOffset);
+            headers.protocols |= classifyApplication(headers.srcPort, headers.dstPort, data.subspan(headers.payloadOffset));
+        }
+
+        void parseL3(std::span<const u8> data, size_t offset, u16 etherType, ParsedHeaders &headers) {
+            if (etherType == EtherTypeARP) {
+                headers.protocols |= pcpp::ARP;
+                headers.l3Offset = toOffset(offset);
+                return;
+            }
+
+            if (etherType == EtherTypeIPv4 && data.size() >= offset + 20) {
+                const auto headerLength = (data[offset] & 0x0F) * 4;
+                if (headerLength < 20 || data.size() < offset + headerLength)
+                    return;
+
+                // Ethernet pads short frames, only the total length belongs to the datagram. Offloaded
+                // segments may be captured with a total length of 0 and are kept whole
+                if (const auto totalLength = readU16(&data[offset + 2]); totalLength >= headerLength)
+                    data = data.first(std::min(data.size(), offset + totalLength));
+
+                headers.protocols |= pcpp::IPv4;
+                headers.l3Offset   = toOffset(offset);
+                headers.ipProtocol = data[offset + 9];
+                headers.srcAddress = { 0, IPv4MappedPrefix | readU32(&data[offset + 12]) };
+                headers.dstAddress = { 0, IPv4MappedPrefix | readU32(&data[offset + 16]) };
+
+                // Only the first fragment carries the transport header
+                if ((readU16(&data[offset + 6]) & 0x1FFF) == 0)
+                    parseL4(data, offset + headerLength, headers);
+            } else if (etherType == EtherTypeIPv6 && data.size() >= offset + 40) {
+                // A payload length of 0 is a jumbogram, its length is in a hop-by-hop option
+                if (const auto payloadLength = readU16(&data[offset + 4]); payloadLength != 0)
+                    data = data.first(std::min(data.size(), offset + 40 + payloadLength));
+
+                headers.protocols |= pcpp::IPv6;
+                headers.l3Offset   = toOffset(offset);
+                headers.srcAddress = { readU64(&data[offset + 8]), readU64(&data[offset + 16]) };
+                headers.dstAddress = { readU64(&data[offset + 24]), readU64(&data[offset + 32]) };
+
+                auto nextHeader = data[offset + 6];
+                offset += 40;
+
+                // Skip hop-by-hop, routing, fragment and destination options headers
+                for (u32 i = 0; i < 8 && data.size() >= offset + 8; i++) {
+                    if (nextHeader == 0 || nextHeader == 43 || nextHeader == 60) {
+                        nextHeader = data[offset];
+                        offset += (data[offset + 1] + 1) * 8;
+                    } else if (nextHeader == 44) {
+                        if ((readU16(&data[offset + 2]) & 0xFFF8) != 0)
+                            return;
+
+                        nextHeader = data[offset];
+                        offset += 8;
+                    } else {
+                        break;
+                    }
+                }
+
+                headers.ipProtocol = nextHeader;
+                if (offset <= data.size())
+                    parseL4(data, offset, headers);
+            }
+        }
+
+        ParsedHeaders parseHeaders(std::span<const u8> data, pcpp::LinkLayerType linkType) {
+            ParsedHeaders headers;
+
+            if (linkType == pcpp::LINKTYPE_ETHERNET) {
+                if (data.size() < 14)
+                    return headers;
+
+                headers.protocols |= pcpp::Ethernet;
+
+                size_t offset = 12;
+                auto etherType = readU16(&data[offset]);
+                while ((etherType == EtherTypeVLAN || etherType == EtherTypeQinQ) && data.size() >= offset + 6) {
+                    headers.protocols |= pcpp::VLAN;
+                    offset += 4;
+                    etherType = readU16(&data[offset]);
+                }
+
+                parseL3(data, offset + 2, etherType, headers);
+            } else if (linkType == pcpp::LINKTYPE_RAW && !data.empty()) {
+                parseL3(data, 0, (data[0] >> 4) == 6 ? EtherTypeIPv6 : EtherTypeIPv4, headers);
+            } else if (linkType == pcpp::LINKTYPE_NULL && data.size() >= 4) {
+                // BSD loopback, the address family is in host byte order
+                const auto family = data[0] | data[3];
+                parseL3(data, 4, family == 2 ? EtherTypeIPv4 : EtherTypeIPv6, headers);
+            }
+
+            return headers;
+        }
+
+    }
+
+    PacketBatch::PacketBatch() {
+        this->m_arena.reserve(ArenaSize);
+
+        auto reserve = [](auto &... columns) { (columns.reserve(MaxPackets), ...); };
+        reserve(this->m_timestamps, this->m_wireLengths, this->m_capturedLengths, this->m_dataOffsets, this->m_l3Offsets, this->m_l4Offsets,
+                this->m_protocols, this->m_srcAddresses, this->m_dstAddresses, this->m_srcPorts, this->m_dstPorts, this->m_ipProtocols,
+                this->m_payloadOffsets, this->m_payloadLengths);
+    }
+
+    i32 PacketBatch::push(std::span<const u8> data, u32 wireLength, timespec timestamp, pcpp::LinkLayerType linkType) {
+        if (this->size() == MaxPackets || this->m_arena.size() + data.size() > ArenaSize)
+            return -1;
+
+        const auto offset = u32(this->m_arena.size());
+        this->m_arena.insert(this->m_arena.end(), data.begin(), data.end());
+
+        const auto headers = parseHeaders(data, linkType);
+
+        this->m_timestamps.push_back(u64(timestamp.tv_sec) * 1'000'000'000 + u64(timestamp.tv_nsec));
+        this->m_wireLengths.push_back(wireLength);
+        this->m_capturedLengths.push_back(u32(data.size()));
+        this->m_dataOffsets.push_back(offset);
+        this->m_l3Offsets.push_back(headers.l3Offset);
+        this->m_l4Offsets.push_back(headers.l4Offset);
+        this->m_protocols.push_back(headers.protocols);
+        this->m_srcAddresses.push_back(headers.srcAddress);
+        this->m_dstAddresses.push_back(headers.dstAddress);
+        this->m_srcPorts.push_back(headers.srcPort);
+        this->m_dstPorts.push_back(headers.dstPort);
+        this->m_ipProtocols.push_back(headers.ipProtocol);
+        this->m_payloadOffsets.push_back(offset + headers.payloadOffset);
+        this->m_payloadLengths.push_back(headers.payloadLength);
+
+        return i32(this->size() - 1);
+    }
+
+    i32 PacketBatch::push(const pcpp::RawPacket &packet) {
+        return this->push({ packet.getRawData(), size_t(packet.getRawDataLen()) }, u32(packet.getFrameLength()), packet.getPacketTimeStamp(), packet.getLinkLayerType());
+    }
+
+    void PacketBatch::clear() {
+        this->m_arena.clear();
+
+        auto clear = [](auto &... columns) { (columns.clear(), ...); };
+        clear(this->m_timestamps, this->m_wireLengths, this->m_capturedLengths, this->m_dataOffsets, this->m_l3Offsets, this->m_l4Offsets,
+              this->m_protocols, this->m_srcAddresses, this->m_dstAddresses, this->m_srcPorts, this->m_dstPorts, this->m_ipProtocols,
+              this->m_payloadOffsets, this->m_payloadLengths);
+    }
+
+
+    namespace kernels {
+
+        void selectProtocols(const PacketBatch &batch, std::span<const u32> indices, pcpp::ProtocolType mask, std::vector<u32> &selected) {
+            const auto protocols = batch.getProtocols().data();
+
+            // Branchless compaction: always write, only advance on a match
+            const auto start = selected.size();
+            selected.resize(start + indices.size());
+
+            auto output = selected.data() + start;
+            size_t count = 0;
+            for (auto index : indices) {
+                output[count] = index;
+                count += (protocols[index] & mask) != 0;
+            }
+
+            selected.resize(start + count);
+        }
+
+        u64 sumWireLengths(const PacketBatch &batch, std::span<const u32> indices) {
+            const auto wireLengths = batch.getWireLengths().data();
+
+            u64 sum = 0;
+            for (auto index : indices)
+                sum += wireLengths[index];
+
+            return sum;
+        }
+
+        void hashFlows(const PacketBatch &batch, std::span<const u32> indices, std::vector<u64> &hashes) {
+            const auto srcAddresses = batch.getSrcAddresses().data(), dstAddresses = batch.getDstAddresses().data();
+            const auto srcPorts = batch.getSrcPorts().data(), dstPorts = batch.getDstPorts().data();
+            const auto ipProtocols = batch.getIpProtocols().data();
+
+            auto mix = [](u64 value) {
+                value ^= value >> 33;
+                value *= 0xFF51AFD7ED558CCDULL;
+                value ^= value >> 33;
+                return value;
+            };
+
+            hashes.resize(indices.size());
+            for (size_t i = 0; i < indices.size(); i++) {
+                const auto index = indices[i];
+
+                // Commutative combination of both endpoints so A->B and B->A land in the same flow
+                const auto src = mix(srcAddresses[index].high ^ mix(srcAddresses[index].low) ^ srcPorts[index]);
+                const auto dst = mix(dstAddresses[index].high ^ mix(dstAddresses[index].low) ^ dstPorts[index]);
+
+                hashes[i] = mix((src + dst) ^ (src * dst) ^ ipProtocols[index]);
+            }
+        }
+
+    }
+
+
+    PacketBatchPool &PacketBatchPool::getInstance() {
+        static PacketBatchPool pool;
+
+        return pool;
+    }
+
+    std::shared_ptr<PacketBatch> PacketBatchPool::acquire() {
+        std::unique_ptr<PacketBatch> batch;
+
+        {
+            std::scoped_lock lock(this->m_mutex);
+
+            if (!this->m_freeBatches.empty()) {
+                batch = std::move(this->m_freeBatches.back());
+                this->m_freeBatches.pop_back();
+            } else {
+                this->m_allocatedBatches++;
+            }
+        }
+
+        if (batch == nullptr)
+            batch = std::make_unique<PacketBatch>();
+
+        return { batch.release(), [this](PacketBatch *batch) { this->release(batch); } };
+    }
+
+    void PacketBatchPool::release(PacketBatch *batch) {
+        batch->clear();
+
+        std::scoped_lock lock(this->m_mutex);
+
+        if (this->m_freeBatches.size() < MaxFreeBatches)
+            this->m_freeBatches.emplace_back(batch);
+        else
+            delete batch;
+    }
+
+
+    std::optional<pcpp::ProtocolType> PacketCapture::push(const pcpp::RawPacket &packet) {
+        std::scoped_lock lock(this->m_mutex);
+
+        if (this->m_current != nullptr) {
+            if (auto row = this->m_current->push(packet); row >= 0)
+                return this->m_current->getProtocols()[row];
+
+            this->m_pending.push_back(std::move(this->m_current));
+        }
+
+        if (this->m_pending.size() >= MaxPendingBatches) {
+            this->m_droppedPackets++;
+            return std::nullopt;
+        }
+
+        this->m_current = PacketBatchPool::getInstance().acquire();
+
+        auto row = this->m_current->push(packet);
+        if (row < 0) {
+            this->m_droppedPackets++; // Larger than a whole batch
+            return std::nullopt;
+        }
+
+        return this->m_current->getProtocols()[row];
+    }
+
+    void PacketCapture::drain(std::vector<std::shared_ptr<PacketBatch>> &batches) {
+        std::scoped_lock lock(this->m_mutex);
+
+        for (auto &batch : this->m_pending)
+            batches.push_back(std::move(batch));
+        this->m_pending.clear();
+
+        if (this->m_current != nullptr && !this->m_current->empty())
+            batches.push_back(std::move(this->m_current));
+    }
+
+    void PacketCapture::clear() {
+        std::scoped_lock lock(this->m_mutex);
+
+        this->m_pending.clear();
+        this->m_current.reset();
+    }
+
+
+    void PacketStream::clear() {
+        // Let go of the batches so they return to the pool, but keep the index storage
+        for (auto &selection : this->m_selections) {
+            selection.batch.reset();
+            selection.indices.clear();
+        }
+
+        this->m_selectionCount = 0;
+    }
+
+    std::vector<u32> &PacketStream::addSelection(std::shared_ptr<PacketBatch> batch) {
+        if (this->m_selectionCount == this->m_selections.size())
+            this->m_selections.emplace_back();
+
+        auto &selection = this->m_selections[this->m_selectionCount++];
+        selection.batch = std::move(batch);
+
+        return selection.indices;
+    }
+
+    void PacketStream::addBatch(std::shared_ptr<PacketBatch> batch) {
+        const auto size = batch->size();
+        auto &indices   = this->addSelection(std::move(batch));
+
+        for (u32 i = 0; i < size; i++)
+            indices.push_back(i);
+    }
+
+}
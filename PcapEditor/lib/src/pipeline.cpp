@@ -0,0 +1,188 @@
+#include <pipeline.hpp>
+
+#include <algorithm>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+
+
+namespace PcapEditor {
+
+    namespace {
+
+        constexpr size_t TileSize = 256;
+
+        // Compacts the rows passing op, out may alias in
+        template<class Operator>
+        size_t select(const Operator &op, const PacketBatch &batch, const u32 *in, size_t count, u32 *out) {
+            size_t selected = 0;
+            for (size_t i = 0; i < count; i++) {
+                const auto index = in[i];
+
+                out[selected] = index;
+                selected += op.test(batch, index);
+            }
+
+            return selected;
+        }
+
+        // The selection is cut into tiles that every operator filters in turn while they're still in L1,
+        // each operator only looks at the rows the previous ones let through
+        template<class... Operators, size_t... Indices>
+        size_t runFused(const PacketOperator *operators, const PacketBatch &batch, const u32 *in, size_t count, u32 *out, std::index_sequence<Indices...>) {
+            const std::tuple<Operators...> fused = { std::get<Operators>(operators[Indices])... };
+
+            size_t selected = 0;
+            for (size_t tile = 0; tile < count; tile += TileSize) {
+                const auto tileOut = out + selected;
+                auto tileCount     = std::min(TileSize, count - tile);
+
+                tileCount = select(std::get<0>(fused), batch, in + tile, tileCount, tileOut);
+                ((tileCount = Indices == 0 ? tileCount : select(std::get<Indices>(fused), batch, tileOut, tileCount, tileOut)), ...);
+
+                selected += tileCount;
+            }
+
+            return selected;
+        }
+
+        template<class... Operators>
+        size_t runKernel(const PacketOperator *operators, const PacketBatch &batch, const u32 *in, size_t count, u32 *out) {
+            return runFused<Operators...>(operators, batch, in, count, out, std::index_sequence_for<Operators...>());
+        }
+
+        template<class... Operators>
+        constexpr auto getKernel(const Operators &...) {
+            return &runKernel<Operators...>;
+        }
+
+    }
+
+    void PacketPipeline::compile(std::span<const PacketOperator> operators) {
+        if (std::equal(operators.begin(), operators.end(), this->m_operators.begin(), this->m_operators.end()))
+            return;
+
+        this->m_operators.assign(operators.begin(), operators.end());
+        this->m_passes.clear();
+
+        for (size_t first = 0; first < this->m_operators.size(); first += MaxFusedOperators) {
+            const auto op = &this->m_operators[first];
+            Kernel kernel;
+
+            switch (std::min(MaxFusedOperators, this->m_operators.size() - first)) {
+                case 1: kernel = std::visit([](const auto &a) { return getKernel(a); }, op[0]); break;
+                case 2: kernel = std::visit([](const auto &a, const auto &b) { return getKernel(a, b); }, op[0], op[1]); break;
+                default: kernel = std::visit([](const auto &a, const auto &b, const auto &c) { return getKernel(a, b, c); }, op[0], op[1], op[2]); break;
+            }
+
+            this->m_passes.push_back({ kernel, first });
+        }
+    }
+
+    void PacketPipeline::run(const PacketBatch &batch, std::span<const u32> indices, std::vector<u32> &selected) const {
+        const auto offset = selected.size();
+        selected.resize(offset + indices.size());
+
+        // The first pass reads the input selection, the following ones filter the output in place
+        const u32 *in = indices.data();
+        u32 *out      = selected.data() + offset;
+        size_t count  = indices.size();
+
+        if (this->m_passes.empty())
+            std::copy(in, in + count, out);
+
+        for (const auto &pass : this->m_passes) {
+            count = pass.kernel(&this->m_operators[pass.firstOperator], batch, in, count, out);
+            in    = out;
+        }
+
+        selected.resize(offset + count);
+    }
+
+    PacketOperatorNode::PacketOperatorNode(std::string unlocalizedTitle)
+        : Node(std::move(unlocalizedTitle),
+               { Attribute(Attribute::IOType::In, Attribute::Type::PacketStream, "hex.builtin.nodes.common.input"),
+                 Attribute(Attribute::IOType::Out, Attribute::Type::PacketStream, "hex.builtin.nodes.common.output") }) { }
+
+    void PacketOperatorNode::process() {
+        // The node at the end of the chain already does this node's work
+        if (this->m_fusedInto != nullptr)
+            return;
+
+        PacketStream *input;
+        this->m_operators.clear();
+
+        if (this->m_chain.empty()) {
+            input = this->getTOnInput<PacketStream, Attribute::Type::PacketStream>(0);
+            this->m_operators.push_back(this->getOperator());
+        } else {
+            // Read the stream entering the head, its source was already evaluated unless the graph is pulled from this node
+            input = this->m_chain.front()->getTOnInput<PacketStream, Attribute::Type::PacketStream>(0);
+
+            // The other nodes may be edited by the UI at the same time, read their parameters under their lock
+            for (auto node : this->m_chain) {
+                if (node == this) {
+                    this->m_operators.push_back(this->getOperator());
+                } else {
+                    std::scoped_lock lock(node->getMutex());
+                    this->m_operators.push_back(node->getOperator());
+                }
+            }
+        }
+
+        this->m_pipeline.compile(this->m_operators);
+
+        this->m_stream.clear();
+        for (const auto &selection : input->getSelections())
+            this->m_pipeline.run(*selection.batch, selection.indices, this->m_stream.addSelection(selection.batch));
+
+        this->setTOnOutput<PacketStream>(1, &this->m_stream);
+    }
+
+    void PacketOperatorNode::fuseChains(const std::vector<Node *> &nodes, const std::vector<std::pair<Attribute *, Attribute *>> &connections) {
+        std::unordered_map<Attribute *, u32> consumers;
+        for (auto &[input, output] : connections)
+            consumers[output]++;
+
+        // A node joins the chain of its input if that's another operator node feeding nothing else
+        std::unordered_map<PacketOperatorNode *, PacketOperatorNode *> previous;
+        std::unordered_map<PacketOperatorNode *, bool> hasNext;
+
+        for (auto node : nodes) {
+            auto operatorNode = dynamic_cast<PacketOperatorNode *>(node);
+            if (operatorNode == nullptr)
+                continue;
+
+            operatorNode->m_fusedInto = nullptr;
+            operatorNode->m_chain.clear();
+
+            auto source = operatorNode->getAttributes()[0].getInputSource();
+            if (source == nullptr || consumers[source] != 1)
+                continue;
+
+            if (auto parent = dynamic_cast<PacketOperatorNode *>(source->getParentNode()); parent != nullptr && parent != operatorNode) {
+                previous[operatorNode] = parent;
+                hasNext[parent]        = true;
+            }
+        }
+
+        for (auto [tail, parent] : previous) {
+            if (hasNext[tail])
+                continue;
+
+            std::vector<PacketOperatorNode *> chain = { tail };
+            for (auto node = previous.find(tail); node != previous.end(); node = previous.find(node->second)) {
+                // Cycles are reported by validation, don't fuse them
+                if (std::find(chain.begin(), chain.end(), node->second) != chain.end())
+                    break;
+
+                chain.push_back(node->second);
+                node->second->m_fusedInto = tail;
+            }
+
+            std::reverse(chain.begin(), chain.end());
+            tail->m_chain = std::move(chain);
+        }
+    }
+
+}
@@ -0,0 +1,68 @@
+#include <profiler.hpp>
+#include <scheduler.hpp>
+
+#include <algorithm>
+#include <unordered_set>
+#include <nlohmann/json.hpp>
+
+
+namespace PcapEditor {
+
+    void Profiler::record(const SchedulerReport &report) {
+        for (const auto &timing : report.timings) {
+            auto &profile = this->m_profiles[timing.nodeId];
+
+            if (profile.calls == 0) {
+                profile.nodeId              = timing.nodeId;
+                profile.title               = timing.title;
+                profile.averageMilliseconds = timing.milliseconds;
+            } else {
+                profile.averageMilliseconds += (timing.milliseconds - profile.averageMilliseconds) * Smoothing;
+            }
+
+            profile.calls++;
+            profile.lastMilliseconds = timing.milliseconds;
+            profile.lastAllocations  = timing.allocations;
+            profile.totalAllocations += timing.allocations;
+            profile.outputBytes      = timing.outputBytes;
+        }
+
+        this->m_maxAverageMilliseconds = 0;
+        for (const auto &[nodeId, profile] : this->m_profiles)
+            this->m_maxAverageMilliseconds = std::max(this->m_maxAverageMilliseconds, profile.averageMilliseconds);
+    }
+
+    void Profiler::retain(const std::vector<Node *> &nodes) {
+        std::unordered_set<u32> ids;
+        for (auto node : nodes)
+            ids.insert(node->getId());
+
+        std::erase_if(this->m_profiles, [&ids](const auto &entry) { return !ids.contains(entry.first); });
+    }
+
+    const NodeProfile *Profiler::get(u32 nodeId) const {
+        auto profile = this->m_profiles.find(nodeId);
+        if (profile == this->m_profiles.end())
+            return nullptr;
+
+        return &profile->second;
+    }
+
+    void Profiler::store(nlohmann::json &j) const {
+        j = nlohmann::json::array();
+
+        for (const auto &[nodeId, profile] : this->m_profiles) {
+            j.push_back({
+                { "id", profile.nodeId },
+                { "title", profile.title },
+                { "calls", profile.calls },
+                { "last_ms", profile.lastMilliseconds },
+                { "average_ms", profile.averageMilliseconds },
+                { "last_allocations", profile.lastAllocations },
+                { "total_allocations", profile.totalAllocations },
+                { "output_bytes", profile.outputBytes }
+            });
+        }
+    }
+
+}
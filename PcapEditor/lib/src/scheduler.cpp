@@ -0,0 +1,176 @@
+#include <scheduler.hpp>
+#include <allocation_counter.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+
+namespace PcapEditor {
+
+    namespace {
+
+        std::vector<Node *> getInputNodes(Node *node) {
+            std::vector<Node *> inputs;
+
+            for (auto &attribute : node->getAttributes()) {
+                if (attribute.getIOType() != Attribute::IOType::In)
+                    continue;
+
+                auto source = attribute.getInputSource();
+                if (source == nullptr)
+                    continue;
+
+                auto parent = source->getParentNode();
+                if (std::find(inputs.begin(), inputs.end(), parent) == inputs.end())
+                    inputs.push_back(parent);
+            }
+
+            return inputs;
+        }
+
+    }
+
+    void Scheduler::buildTasks(const std::vector<Node *> &endNodes) {
+        enum class Mark { Visiting, Done };
+
+        std::unordered_map<Node *, Mark> marks;
+        std::unordered_map<Node *, u32> indices;
+        std::vector<std::pair<Node *, std::vector<Node *>>> order;
+
+        // Post-order walk upstream from every end node, so inputs always get a lower index than their consumers
+        std::function<void(Node *)> visit = [&](Node *node) {
+            auto [iter, inserted] = marks.try_emplace(node, Mark::Visiting);
+            if (!inserted) {
+                if (iter->second == Mark::Visiting)
+                    throw Node::NodeError(node, "Recursion detected!");
+                return;
+            }
+
+            auto inputs = getInputNodes(node);
+            for (auto input : inputs)
+                visit(input);
+
+            iter->second = Mark::Done;
+            indices[node] = order.size();
+            order.emplace_back(node, std::move(inputs));
+        };
+
+        for (auto endNode : endNodes)
+            visit(endNode);
+
+        this->m_tasks = std::vector<Task>(order.size());
+        for (u32 i = 0; i < order.size(); i++) {
+            auto &[node, inputs] = order[i];
+
+            // Folded nodes keep the outputs of the evaluation that folded them
+            node->resetProcessedInputs();
+            if (node->isFolded())
+                node->setProcessed();
+            else
+                node->resetOutputData();
+
+            this->m_tasks[i].node = node;
+            this->m_tasks[i].remainingInputs = inputs.size();
+            for (auto input : inputs)
+                this->m_tasks[indices[input]].dependents.push_back(i);
+        }
+    }
+
+    void Scheduler::schedule(u32 index) {
+        this->m_outstanding++;
+
+        if (this->m_tasks[index].node->isThreadSafe())
+            this->m_pool.submit([this, index] { this->run(index); });
+        else
+            this->m_pool.submitPinned([this, index] { this->run(index); });
+    }
+
+    void Scheduler::run(u32 index) {
+        auto &task = this->m_tasks[index];
+
+        bool failed = false;
+
+        if (!task.skipped && !this->m_aborted && !task.node->isFolded()) {
+            const auto start       = std::chrono::steady_clock::now();
+            const auto allocations = allocation::getThreadCount();
+            u64 allocationsMade    = 0;
+            std::vector<u64> outputBytes;
+
+            try {
+                std::scoped_lock nodeLock(task.node->getMutex());
+
+                task.node->process();
+                task.node->setProcessed();
+
+                allocationsMade = allocation::getThreadCount() - allocations;
+
+                for (auto &attribute : task.node->getAttributes()) {
+                    if (attribute.getIOType() == Attribute::IOType::Out)
+                        outputBytes.push_back(attribute.getOutputData().getBytes().size());
+                }
+            } catch (Node::NodeError &e) {
+                std::scoped_lock lock(this->m_resultMutex);
+                this->m_report.errors.push_back({ e.first->getId(), e.second });
+                failed = true;
+            } catch (...) {
+                std::scoped_lock lock(this->m_resultMutex);
+                if (!this->m_error)
+                    this->m_error = std::current_exception();
+                this->m_aborted = true;
+            }
+
+            const auto duration = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            {
+                std::scoped_lock lock(this->m_resultMutex);
+                this->m_report.timings.push_back({ task.node->getId(), task.node->getUnlocalizedTitle(), duration, !task.node->isThreadSafe(), allocationsMade, std::move(outputBytes) });
+                this->m_report.busyMilliseconds += duration;
+            }
+        }
+
+        // Skipped tasks are still scheduled so their own dependents get released and skipped in turn
+        if (!this->m_aborted) {
+            for (auto dependent : task.dependents) {
+                if (failed || task.skipped)
+                    this->m_tasks[dependent].skipped = true;
+
+                if (--this->m_tasks[dependent].remainingInputs == 0)
+                    this->schedule(dependent);
+            }
+        }
+
+        if (--this->m_outstanding == 0)
+            this->m_pool.notifyWaiter();
+    }
+
+    void Scheduler::evaluate(const std::vector<Node *> &endNodes) {
+        const auto start       = std::chrono::steady_clock::now();
+        const auto bytesCopied = SharedBuffer::getBytesCopied();
+
+        this->m_report = SchedulerReport();
+        this->m_report.workerCount = this->m_pool.getWorkerCount();
+        this->m_error = nullptr;
+        this->m_aborted = false;
+
+        this->buildTasks(endNodes);
+
+        // Collect the sources first, scheduled tasks already start releasing their dependents
+        std::vector<u32> sources;
+        for (u32 i = 0; i < this->m_tasks.size(); i++) {
+            if (this->m_tasks[i].remainingInputs == 0)
+                sources.push_back(i);
+        }
+
+        for (auto source : sources)
+            this->schedule(source);
+
+        this->m_pool.waitUntil([this] { return this->m_outstanding == 0; });
+
+        this->m_report.wallMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        this->m_report.bytesCopied      = SharedBuffer::getBytesCopied() - bytesCopied;
+
+        if (this->m_error)
+            std::rethrow_exception(this->m_error);
+    }
+
+}
@@ -0,0 +1,27 @@
+#include <shared_buffer.hpp>
+
+
+namespace PcapEditor {
+
+    std::atomic<u64> SharedBuffer::s_bytesCopied = 0;
+
+    std::vector<u8> &SharedBuffer::mutate() {
+        if (!this->m_storage) {
+            this->m_storage = std::make_shared<std::vector<u8>>();
+        } else if (this->m_storage.use_count() > 1 || this->m_offset != 0 || this->size() != this->m_storage->size()) {
+            this->m_storage = std::make_shared<std::vector<u8>>(this->toVector());
+        }
+
+        this->m_offset = 0;
+        this->m_size   = WholeStorage;
+
+        return *this->m_storage;
+    }
+
+    std::vector<u8> SharedBuffer::toVector() const {
+        s_bytesCopied += this->size();
+
+        return { this->begin(), this->end() };
+    }
+
+}
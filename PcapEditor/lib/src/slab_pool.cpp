@@ -0,0 +1,70 @@
+#include <slab_pool.hpp>
+
+#include <algorithm>
+#include <new>
+
+
+namespace PcapEditor {
+
+    namespace {
+
+        constexpr size_t getSizeClass(size_t size) {
+            return (std::max<size_t>(size, 1) + SlabPool::Granularity - 1) / SlabPool::Granularity - 1;
+        }
+
+    }
+
+    SlabPool &SlabPool::getInstance() {
+        static SlabPool pool;
+
+        return pool;
+    }
+
+    void *SlabPool::allocate(size_t size) {
+        if (size > MaxBlockSize)
+            return ::operator new(size);
+
+        const auto sizeClass = getSizeClass(size);
+        const auto blockSize = (sizeClass + 1) * Granularity;
+
+        std::scoped_lock lock(this->m_mutex);
+        this->m_bytesInUse += blockSize;
+
+        if (auto block = this->m_freeLists[sizeClass]; block != nullptr) {
+            this->m_freeLists[sizeClass] = block->next;
+            return block;
+        }
+
+        // The rest of a slab too small for the block is left unused
+        if (this->m_cursor == nullptr || size_t(this->m_end - this->m_cursor) < blockSize) {
+            this->m_slabs.push_back(std::make_unique<std::byte[]>(SlabSize));
+            this->m_cursor = this->m_slabs.back().get();
+            this->m_end    = this->m_cursor + SlabSize;
+        }
+
+        auto block = this->m_cursor;
+        this->m_cursor += blockSize;
+
+        return block;
+    }
+
+    void SlabPool::deallocate(void *pointer, size_t size) {
+        if (pointer == nullptr)
+            return;
+
+        if (size > MaxBlockSize) {
+            ::operator delete(pointer);
+            return;
+        }
+
+        const auto sizeClass = getSizeClass(size);
+
+        std::scoped_lock lock(this->m_mutex);
+        this->m_bytesInUse -= (sizeClass + 1) * Granularity;
+
+        auto block  = static_cast<FreeBlock *>(pointer);
+        block->next = this->m_freeLists[sizeClass];
+        this->m_freeLists[sizeClass] = block;
+    }
+
+}
@@ -0,0 +1,154 @@
+#include <thread_pool.hpp>
+
+
+namespace PcapEditor {
+
+    namespace {
+        // Index of the pool queue owned by the current thread, -1 outside of worker threads
+        thread_local i32 s_workerIndex = -1;
+    }
+
+    ThreadPool::ThreadPool(u32 workerCount) {
+        if (workerCount == 0) {
+            auto hardwareThreads = std::thread::hardware_concurrency();
+            workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+        }
+
+        for (u32 i = 0; i < workerCount; i++)
+            this->m_queues.push_back(std::make_unique<Queue>());
+
+        for (u32 i = 0; i < workerCount; i++)
+            this->m_workers.emplace_back([this, i] { this->workerLoop(i); });
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::scoped_lock lock(this->m_sleepMutex);
+            this->m_stop = true;
+        }
+        this->m_workerCondition.notify_all();
+
+        for (auto &worker : this->m_workers)
+            worker.join();
+    }
+
+    void ThreadPool::submit(Task task) {
+        u32 index = s_workerIndex >= 0 ? static_cast<u32>(s_workerIndex) : this->m_nextQueue++ % this->m_queues.size();
+
+        // Counted under the queue lock the workers pop with, a worker taking the task right away can't wrap the counter
+        {
+            std::scoped_lock lock(this->m_queues[index]->mutex);
+            this->m_queues[index]->tasks.push_back(std::move(task));
+            this->m_queuedTasks++;
+        }
+
+        // Workers check the counter under the sleep lock, they either see the task or are already waiting for the notification
+        {
+            std::scoped_lock lock(this->m_sleepMutex);
+        }
+        this->m_workerCondition.notify_one();
+        this->m_waiterCondition.notify_one();
+    }
+
+    void ThreadPool::submitPinned(Task task) {
+        {
+            std::scoped_lock lock(this->m_pinnedQueue.mutex);
+            this->m_pinnedQueue.tasks.push_back(std::move(task));
+        }
+
+        this->notifyWaiter();
+    }
+
+    void ThreadPool::notifyWaiter() {
+        {
+            std::scoped_lock lock(this->m_sleepMutex);
+        }
+        this->m_waiterCondition.notify_all();
+    }
+
+    bool ThreadPool::popLocal(u32 index, Task &task) {
+        auto &queue = *this->m_queues[index];
+        std::scoped_lock lock(queue.mutex);
+
+        if (queue.tasks.empty())
+            return false;
+
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        this->m_queuedTasks--;
+
+        return true;
+    }
+
+    bool ThreadPool::steal(u32 thief, Task &task) {
+        const auto queueCount = static_cast<u32>(this->m_queues.size());
+
+        for (u32 i = 1; i <= queueCount; i++) {
+            auto &queue = *this->m_queues[(thief + i) % queueCount];
+            std::scoped_lock lock(queue.mutex);
+
+            if (queue.tasks.empty())
+                continue;
+
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            this->m_queuedTasks--;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    bool ThreadPool::popPinned(Task &task) {
+        std::scoped_lock lock(this->m_pinnedQueue.mutex);
+
+        if (this->m_pinnedQueue.tasks.empty())
+            return false;
+
+        task = std::move(this->m_pinnedQueue.tasks.front());
+        this->m_pinnedQueue.tasks.pop_front();
+
+        return true;
+    }
+
+    void ThreadPool::workerLoop(u32 index) {
+        s_workerIndex = static_cast<i32>(index);
+
+        while (true) {
+            Task task;
+
+            if (this->popLocal(index, task) || this->steal(index, task)) {
+                task();
+                continue;
+            }
+
+            std::unique_lock lock(this->m_sleepMutex);
+            this->m_workerCondition.wait(lock, [this] { return this->m_stop || this->m_queuedTasks > 0; });
+
+            if (this->m_stop)
+                return;
+        }
+    }
+
+    void ThreadPool::waitUntil(const std::function<bool()> &done) {
+        while (!done()) {
+            Task task;
+
+            if (this->popPinned(task) || this->steal(0, task)) {
+                task();
+                continue;
+            }
+
+            std::unique_lock lock(this->m_sleepMutex);
+            this->m_waiterCondition.wait(lock, [&, this] {
+                if (this->m_queuedTasks > 0 || done())
+                    return true;
+
+                std::scoped_lock pinnedLock(this->m_pinnedQueue.mutex);
+                return !this->m_pinnedQueue.tasks.empty();
+            });
+        }
+    }
+
+}
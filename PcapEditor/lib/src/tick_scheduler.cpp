@@ -0,0 +1,50 @@
+#include <tick_scheduler.hpp>
+
+#include <algorithm>
+#include <limits>
+
+
+namespace PcapEditor {
+
+    TickScheduler::TickScheduler(double rate, Policy policy) : m_policy(policy) {
+        this->setRate(rate);
+    }
+
+    void TickScheduler::setRate(double rate) {
+        const auto previousInterval = this->m_interval;
+
+        this->m_rate     = std::clamp(rate, MinRate, MaxRate);
+        this->m_interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / this->m_rate));
+
+        // Re-base the pending deadline on the last tick so lowering the interval takes effect right away
+        if (this->m_deadline != Clock::time_point())
+            this->m_deadline += this->m_interval - previousInterval;
+    }
+
+    void TickScheduler::start(Clock::time_point now) {
+        this->m_deadline = now;
+    }
+
+    u32 TickScheduler::advance(Clock::time_point now) {
+        if (now < this->m_deadline)
+            return 0;
+
+        // Deadlines that passed since the one we are serving
+        const u64 late    = (now - this->m_deadline) / this->m_interval;
+        const u64 pending = late + 1;
+
+        u32 ticks = 1;
+        if (this->m_policy == Policy::CatchUp)
+            ticks = static_cast<u32>(std::min<u64>(pending, MaxCatchUpTicks));
+
+        this->m_ticks += ticks;
+        this->m_missedDeadlines += late;
+        this->m_lastDroppedTicks = static_cast<u32>(std::min<u64>(pending - ticks, std::numeric_limits<u32>::max()));
+        this->m_droppedTicks += pending - ticks;
+
+        this->m_deadline += this->m_interval * pending;
+
+        return ticks;
+    }
+
+}
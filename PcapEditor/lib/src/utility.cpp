@@ -18,7 +18,7 @@ namespace utility
         return nodes;
     }   
 
-    std::string hexStr(u8 *data, u32 len)
+    std::string hexStr(const u8 *data, u32 len)
     {
         std::stringstream ss;
         ss << std::hex;
@@ -7,7 +7,7 @@
 #include <SDL.h>
 #include <GL/gl3w.h>
 
-int main(int, char**)
+int main(int argc, char** argv)
 {
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER) != 0)
     {
@@ -78,6 +78,8 @@ int main(int, char**)
     }
 
     PcapEditor::PcapEditor pcap_editor("pcap__editor__");
+    if (argc > 1)
+        pcap_editor.loadGraphOnStart(argv[1]);
     while (!done)
     {
         SDL_Event event;
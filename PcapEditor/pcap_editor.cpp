@@ -1,6 +1,13 @@
 #include "pcap_editor.h"
 #include <provider.hpp>
 #include <concrete_nodes.hpp>
+#include <graph_file.hpp>
+#include <node_group.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <fmt/ranges.h>
+#include <nlohmann/json.hpp>
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include <imgui_internal.h>
 #undef IMGUI_DEFINE_MATH_OPERATOR
@@ -17,54 +24,202 @@ void PcapEditor::NodeEditorInitialize()
     
     registerNodes();  
     registerProvider(); 
-    
+
+    if (this->m_loadGraphOnStart)
+        this->loadGraph();
 }
-void PcapEditor::eraseLink(u32 id) {
-        auto link = std::find_if(this->m_links.begin(), this->m_links.end(), [&id](auto link) { return link.getId() == id; });
 
-        if (link == this->m_links.end())
+void PcapEditor::setGraphPath(const std::string &path) {
+        this->m_graphPath = path;
+        this->m_graphPath.resize(0xFFF, 0x00);
+    }
+
+    void PcapEditor::loadGraphOnStart(const std::string &path) {
+        this->setGraphPath(path);
+        this->m_loadGraphOnStart = true;
+    }
+
+    void PcapEditor::saveGraph() {
+        const std::string path = this->m_graphPath.c_str();
+        const auto start       = std::chrono::steady_clock::now();
+
+        GraphFile::Positions positions;
+        for (auto node : this->m_graph.getNodes())
+            positions[node->getId()] = ImNodes::GetNodeGridSpacePos(node->getId());
+
+        std::vector<u8> data;
+        if (path.ends_with(".json")) {
+            nlohmann::json j;
+            GraphFile::storeJson(this->m_graph, positions, j);
+
+            const auto text = j.dump(4);
+            data.assign(text.begin(), text.end());
+        } else {
+            data = GraphFile::storeBinary(this->m_graph, positions);
+        }
+
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char *>(data.data()), data.size());
+
+        if (!file)
+            this->m_graphFileStatus = utility::format("Failed to write {0}", path);
+        else
+            this->m_graphFileStatus = utility::format("Saved {0} nodes in {1:.1f} ms", this->m_graph.getNodes().size(), std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    void PcapEditor::loadGraph() {
+        const std::string path = this->m_graphPath.c_str();
+        const auto start       = std::chrono::steady_clock::now();
+
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            this->m_graphFileStatus = utility::format("Failed to open {0}", path);
             return;
+        }
 
-        for (auto &node : this->m_nodes) {
-            for (auto &attribute : node->getAttributes()) {
-                attribute.removeConnectedAttribute(id);
-            }
+        std::vector<u8> data(file.tellg());
+        file.seekg(0);
+        file.read(reinterpret_cast<char *>(data.data()), data.size());
+
+        // Load next to the current graph first, a broken file leaves it untouched
+        GraphRegistry graph;
+        GraphFile::Positions positions;
+        try {
+            if (GraphFile::isBinary(data))
+                GraphFile::loadBinary(data, graph, positions);
+            else
+                GraphFile::loadJson(nlohmann::json::parse(data.begin(), data.end()), graph, positions);
+        } catch (std::exception &e) {
+            this->m_graphFileStatus = utility::format("Failed to load {0}: {1}", path, e.what());
+            return;
         }
 
-        this->m_links.erase(link);
+        std::vector<int> ids;
+        for (auto node : this->m_graph.getNodes())
+            ids.push_back(node->getId());
+        this->eraseNodes(ids);
+
+        this->m_graph = std::move(graph);
+        for (const auto &[id, position] : positions)
+            ImNodes::SetNodeGridSpacePos(id, position);
 
+        this->m_graphChanged    = true;
+        this->m_graphFileStatus = utility::format("Loaded {0} nodes in {1:.1f} ms", this->m_graph.getNodes().size(), std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+void PcapEditor::eraseLink(u32 id) {
+        if (this->m_graph.eraseLink(id))
+            this->m_graphChanged = true;
     }
 
     void PcapEditor::eraseNodes(const std::vector<int> &ids) {
-        for (const int id : ids) {
-            auto node = std::find_if(this->m_nodes.begin(), this->m_nodes.end(), [&id](auto node) { return node->getId() == id; });
+        for (auto node : this->m_graph.eraseNodes(ids)) {
+            this->m_nodeContentSizes.erase(node->getId());
 
-            for (auto &attr : (*node)->getAttributes()) {
-                std::vector<u32> linksToRemove;
-                for (auto &[linkId, connectedAttr] : attr.getConnectedAttributes())
-                    linksToRemove.push_back(linkId);
+            // The evaluation thread may still be working on this node, free it once it got a snapshot without it
+            this->m_erasedNodes.push_back(node);
+        }
 
-                for (auto linkId : linksToRemove)
-                    eraseLink(linkId);
-            }
+        this->m_graphChanged = true;
+    }
+
+    void PcapEditor::drawNodeContent(Node *node) {
+        // Content sizes are kept at zoom 1, the placeholders scale with the editor's zoom
+        const auto zoom = ImNodes::EditorContextGetZoom();
+
+        // Nodes outside of the view or too small to read only need their size, their title and pins are still submitted for the links
+        if (!ImNodes::IsNodeVisible(node->getId())) {
+            ImGui::Dummy(this->m_nodeContentSizes[node->getId()] * zoom);
+            return;
+        }
+
+        // Never stall the frame on a node that's being processed, keep its space reserved and draw it next frame
+        std::unique_lock lock(node->getMutex(), std::try_to_lock);
+
+        if (!lock.owns_lock()) {
+            ImGui::Dummy(this->m_nodeContentSizes[node->getId()] * zoom);
+            return;
         }
 
-        for (const int id : ids) {
-            auto node = std::find_if(this->m_nodes.begin(), this->m_nodes.end(), [&id](auto node) { return node->getId() == id; });
+        ImGui::BeginGroup();
+        node->drawNode();
+        ImGui::EndGroup();
+
+        this->m_nodeContentSizes[node->getId()] = ImGui::GetItemRectSize() / zoom;
+    }
+
+    void PcapEditor::groupNodes(const std::vector<int> &ids) {
+        std::vector<ImVec2> positions;
+        for (auto id : ids)
+            positions.push_back(ImNodes::GetNodeGridSpacePos(id));
 
-            std::erase_if(this->m_endNodes, [&id](auto node) { return node->getId() == id; });
+        ImVec2 position;
+        auto group = NodeGroup::collapse(this->m_graph, ids, positions, position);
+        ImNodes::SetNodeGridSpacePos(group->getId(), position);
 
-            delete *node;
+        for (auto id : ids)
+            this->m_nodeContentSizes.erase(id);
 
-            this->m_nodes.erase(node);
+        this->m_graphChanged = true;
+    }
+
+    void PcapEditor::expandGroup(u32 id) {
+        auto group = dynamic_cast<NodeGroup *>(this->m_graph.getNode(id));
+        if (group == nullptr)
+            return;
+
+        const auto position = ImNodes::GetNodeGridSpacePos(id);
+        for (const auto &[node, offset] : group->expand(this->m_graph))
+            ImNodes::SetNodeGridSpacePos(node->getId(), position + offset);
+
+        this->m_nodeContentSizes.erase(id);
+
+        // Freed like an erased node, the evaluation thread may still be running it
+        this->m_erasedNodes.push_back(group);
+        this->m_graphChanged = true;
+    }
+
+    void PcapEditor::submitGraphChanges() {
+        if (this->m_graphChanged) {
+            GraphSnapshot snapshot;
+            snapshot.nodes    = this->m_graph.getNodes();
+            snapshot.endNodes = this->m_graph.getEndNodes();
+
+            for (auto node : snapshot.nodes) {
+                for (auto &attribute : node->getAttributes()) {
+                    if (attribute.getIOType() != Attribute::IOType::In || attribute.getConnectedAttributes().empty())
+                        continue;
+
+                    snapshot.connections.emplace_back(&attribute, attribute.getConnectedAttributes().begin()->second);
+                }
+            }
+
+            const auto generation = this->m_evaluator.setSnapshot(std::move(snapshot));
+
+            for (auto node : this->m_erasedNodes)
+                this->m_retiredNodes.emplace_back(generation, node);
+            this->m_erasedNodes.clear();
+
+            this->m_graphChanged = false;
         }
 
+        const auto appliedSnapshot = this->m_evaluator.getAppliedSnapshot();
+        std::erase_if(this->m_retiredNodes, [appliedSnapshot](const auto &retired) {
+            if (retired.first > appliedSnapshot)
+                return false;
+
+            delete retired.second;
+            return true;
+        });
     }
 void PcapEditor::NodeEditorShow()
 {
     if (ImGui::Begin("hex.builtin.view.data_processor.name", NULL, ImGuiWindowFlags_NoCollapse)) {
 
             if (ImGui::IsMouseReleased(ImGuiMouseButton_Right) && ImGui::IsWindowHovered(ImGuiHoveredFlags_ChildWindows)) {
+                this->m_menuSelection.resize(ImNodes::NumSelectedNodes());
+                if (!this->m_menuSelection.empty())
+                    ImNodes::GetSelectedNodes(this->m_menuSelection.data());
+
                 ImNodes::ClearNodeSelection();
                 ImNodes::ClearLinkSelection();
 
@@ -99,6 +254,9 @@ void PcapEditor::NodeEditorShow()
                     }
                 }
 
+                if (this->m_menuSelection.size() > 1 && ImGui::MenuItem("hex.builtin.view.data_processor.menu.group"))
+                    this->groupNodes(this->m_menuSelection);
+
                 for (const auto &[unlocalizedCategory, unlocalizedName, function] : utility::getEntries()) {
                     if (unlocalizedCategory.empty() && unlocalizedName.empty()) {
                         ImGui::Separator();
@@ -117,20 +275,9 @@ void PcapEditor::NodeEditorShow()
                 }
 
                 if (node != nullptr) {
-                    this->m_nodes.push_back(node);
-
-                    bool hasOutput = false;
-                    bool hasInput  = false;
-                    for (auto &attr : node->getAttributes()) {
-                        if (attr.getIOType() == Attribute::IOType::Out)
-                            hasOutput = true;
-
-                        if (attr.getIOType() == Attribute::IOType::In)
-                            hasInput = true;
-                    }
+                    this->m_graph.addNode(node);
 
-                    if (hasInput && !hasOutput)
-                        this->m_endNodes.push_back(node);
+                    this->m_graphChanged = true;
 
                     ImNodes::SetNodeScreenSpacePos(node->getId(), this->m_rightClickedCoords);
                 }
@@ -142,6 +289,13 @@ void PcapEditor::NodeEditorShow()
                 if (ImGui::MenuItem("hex.builtin.view.data_processor.menu.remove_node"))
                     this->eraseNodes({ this->m_rightClickedId });
 
+                if (auto group = dynamic_cast<NodeGroup *>(this->m_graph.getNode(this->m_rightClickedId)); group != nullptr) {
+                    if (ImGui::MenuItem("hex.builtin.view.data_processor.menu.expand_group"))
+                        this->expandGroup(group->getId());
+                    else if (ImGui::MenuItem("hex.builtin.view.data_processor.menu.save_template"))
+                        group->addTemplate();
+                }
+
                 ImGui::EndPopup();
             }
 
@@ -152,33 +306,52 @@ void PcapEditor::NodeEditorShow()
                 ImGui::EndPopup();
             }
 
+            this->m_evaluator.fetchResult(this->m_evaluationResult);
+
             {
                 int nodeId;
-                if (ImNodes::IsNodeHovered(&nodeId) && this->m_currNodeError.has_value() && this->m_currNodeError->first->getId() == nodeId) {
-                    ImGui::BeginTooltip();
-                    ImGui::TextUnformatted("hex.builtin.common.error");
-                    ImGui::Separator();
-                    ImGui::TextUnformatted(this->m_currNodeError->second.c_str());
-                    ImGui::EndTooltip();
+                if (ImNodes::IsNodeHovered(&nodeId)) {
+                    if (auto error = this->m_evaluationResult.getError(nodeId); error != nullptr) {
+                        ImGui::BeginTooltip();
+                        ImGui::TextUnformatted("hex.builtin.common.error");
+                        ImGui::Separator();
+                        ImGui::TextUnformatted(error->message.c_str());
+                        ImGui::EndTooltip();
+                    }
                 }
             }
 
             if (ImGui::BeginChild("##node_editor", ImGui::GetContentRegionAvail() - ImVec2(0, ImGui::GetTextLineHeightWithSpacing() * 1.3))) {
                 ImNodes::BeginNodeEditor();
 
-                for (auto &node : this->m_nodes) {
-                    const bool hasError = this->m_currNodeError.has_value() && this->m_currNodeError->first == node;
+                for (auto node : this->m_graph.getNodes()) {
+                    const bool hasError = this->m_evaluationResult.getError(node->getId()) != nullptr;
+                    const auto profile  = this->m_evaluationResult.profiler.get(node->getId());
 
-                    if (hasError)
+                    if (hasError) {
                         ImNodes::PushColorStyle(ImNodesCol_NodeOutline, 0xFF0000FF);
+                    } else if (profile != nullptr) {
+                        // Heatmap relative to the most expensive node, green to red
+                        const auto maxCost = this->m_evaluationResult.profiler.getMaxAverageMilliseconds();
+                        const float heat   = maxCost > 0 ? float(profile->averageMilliseconds / maxCost) : 0.0F;
+
+                        ImNodes::PushColorStyle(ImNodesCol_NodeOutline, ImGui::ColorConvertFloat4ToU32(ImVec4(heat, 1.0F - heat, 0.0F, 1.0F)));
+                    }
 
                     ImNodes::BeginNode(node->getId());
 
                     ImNodes::BeginNodeTitleBar();
                     ImGui::TextUnformatted((node->getUnlocalizedTitle().c_str()));
+                    if (this->m_evaluationResult.isFolded(node->getId())) {
+                        ImGui::SameLine();
+                        ImGui::TextFormattedDisabled("folded");
+                    } else if (profile != nullptr) {
+                        ImGui::SameLine();
+                        ImGui::TextFormattedDisabled("{0:.2f} ms (avg {1:.2f})", profile->lastMilliseconds, profile->averageMilliseconds);
+                    }
                     ImNodes::EndNodeTitleBar();
 
-                    node->drawNode();
+                    this->drawNodeContent(node);
 
                     for (auto &attribute : node->getAttributes()) {
                         ImNodesPinShape pinShape;
@@ -205,9 +378,17 @@ void PcapEditor::NodeEditorShow()
                             case Attribute::Type::Pointer:
                                 pinShape = ImNodesPinShape_TriangleFilled;
                                 break;
+                            case Attribute::Type::PacketStream:
+                                pinShape = ImNodesPinShape_Quad;
+                                break;
                             
                         }
 
+                        // Streams share the buffer's shape, tell them apart by color
+                        const bool isStream = attribute.getType() == Attribute::Type::PacketStream;
+                        if (isStream)
+                            ImNodes::PushColorStyle(ImNodesCol_Pin, 0xFF20A0F0);
+
                         if (attribute.getIOType() == Attribute::IOType::In) {
                             ImNodes::BeginInputAttribute(attribute.getId(), pinShape);
                             ImGui::TextUnformatted((attribute.getUnlocalizedName().c_str()));
@@ -217,15 +398,18 @@ void PcapEditor::NodeEditorShow()
                             ImGui::TextUnformatted((attribute.getUnlocalizedName().c_str()));
                             ImNodes::EndOutputAttribute();
                         }
+
+                        if (isStream)
+                            ImNodes::PopColorStyle();
                     }
 
                     ImNodes::EndNode();
 
-                    if (hasError)
+                    if (hasError || profile != nullptr)
                         ImNodes::PopColorStyle();
                 }
 
-                for (const auto &link : this->m_links)
+                for (const auto &[id, link] : this->m_graph.getLinks())
                     ImNodes::Link(link.getId(), link.getFromId(), link.getToId());
 
                 ImNodes::MiniMap(0.2F, ImNodesMiniMapLocation_BottomRight);
@@ -234,14 +418,102 @@ void PcapEditor::NodeEditorShow()
             }
             ImGui::EndChild();
 
-            // std::printf("process Nodes below");
-            if (ImGui::Button("Process") || this->m_continuousEvaluation){                    
-                this->processNodes();
+            if (ImGui::Button("Process"))
+                this->m_evaluator.requestEvaluation();
+
+            ImGui::SameLine();
+            ImGui::TextFormatted("{0} folded", this->m_evaluationResult.foldedNodes.size());
+
+            ImGui::SameLine();
+            if (ImGui::Checkbox("Continuous evaluation", &this->m_continuousEvaluation))
+                this->m_evaluator.setContinuous(this->m_continuousEvaluation);
+
+            ImGui::SameLine();
+            ImGui::PushItemWidth(ImGui::GetTextLineHeight() * 5);
+            if (ImGui::DragFloat("Hz", &this->m_tickRate, 1.0F, TickScheduler::MinRate, TickScheduler::MaxRate, "%.1f", ImGuiSliderFlags_AlwaysClamp))
+                this->m_evaluator.setTickRate(this->m_tickRate);
+
+            ImGui::SameLine();
+            if (ImGui::Combo("##tick_policy", &this->m_tickPolicy, "Skip\0Catch up\0"))
+                this->m_evaluator.setTickPolicy(this->m_tickPolicy == 0 ? TickScheduler::Policy::Skip : TickScheduler::Policy::CatchUp);
+            ImGui::PopItemWidth();
+
+            ImGui::SameLine();
+            ImGui::TextFormatted("{0} ticks, {1} missed deadlines, {2} dropped", this->m_evaluationResult.ticks, this->m_evaluationResult.missedDeadlines, this->m_evaluationResult.droppedTicks);
+
+            ImGui::SameLine();
+            if (ImGui::Button("Scheduler report"))
+                ImGui::OpenPopup("Scheduler Report");
+
+            if (ImGui::BeginPopup("Scheduler Report")) {
+                const auto &report = this->m_evaluationResult.report;
+
+                ImGui::TextFormatted("{0} nodes on {1} workers, {2:.3f} ms wall, {3:.3f} ms busy", report.timings.size(), report.workerCount, report.wallMilliseconds, report.busyMilliseconds);
+                ImGui::TextFormatted("{0} buffer bytes copied", report.bytesCopied);
+                ImGui::Separator();
+
+                if (ImGui::BeginTable("##timings", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY, ImVec2(700, 300))) {
+                    ImGui::TableSetupColumn("Node");
+                    ImGui::TableSetupColumn("Thread");
+                    ImGui::TableSetupColumn("Time (ms)");
+                    ImGui::TableSetupColumn("Average (ms)");
+                    ImGui::TableSetupColumn("Calls");
+                    ImGui::TableSetupColumn("Allocations");
+                    ImGui::TableSetupColumn("Output bytes");
+                    ImGui::TableHeadersRow();
+
+                    for (const auto &timing : report.timings) {
+                        const auto profile = this->m_evaluationResult.profiler.get(timing.nodeId);
+
+                        ImGui::TableNextRow();
+                        ImGui::TableNextColumn();
+                        ImGui::TextFormatted("{0} #{1}", timing.title, timing.nodeId);
+                        ImGui::TableNextColumn();
+                        ImGui::TextUnformatted(timing.pinned ? "main" : "pool");
+                        ImGui::TableNextColumn();
+                        ImGui::TextFormatted("{0:.3f}", timing.milliseconds);
+                        ImGui::TableNextColumn();
+                        if (profile != nullptr)
+                            ImGui::TextFormatted("{0:.3f}", profile->averageMilliseconds);
+                        ImGui::TableNextColumn();
+                        if (profile != nullptr)
+                            ImGui::TextFormatted("{0}", profile->calls);
+                        ImGui::TableNextColumn();
+                        ImGui::TextFormatted("{0}", timing.allocations);
+                        ImGui::TableNextColumn();
+                        ImGui::TextFormatted("{0}", fmt::join(timing.outputBytes, ", "));
+                    }
+
+                    ImGui::EndTable();
+                }
+
+                if (ImGui::Button("Export profile")) {
+                    nlohmann::json j;
+                    this->m_evaluationResult.profiler.store(j);
+
+                    std::ofstream(ProfileExportPath) << j.dump(4);
+                }
+                ImGui::SameLine();
+                ImGui::TextFormattedDisabled("to {0}", ProfileExportPath);
+
+                ImGui::EndPopup();
             }
-                
 
             ImGui::SameLine();
-            ImGui::Checkbox("Continuous evaluation", &this->m_continuousEvaluation);
+            ImGui::PushItemWidth(ImGui::GetTextLineHeight() * 10);
+            ImGui::InputText("##graph_path", this->m_graphPath.data(), this->m_graphPath.size() - 1);
+            ImGui::PopItemWidth();
+
+            ImGui::SameLine();
+            if (ImGui::Button("Save"))
+                this->saveGraph();
+
+            ImGui::SameLine();
+            if (ImGui::Button("Load"))
+                this->loadGraph();
+
+            ImGui::SameLine();
+            ImGui::TextFormattedDisabled("{0}", this->m_graphFileStatus);
 
             {
                 int linkId;
@@ -253,35 +525,8 @@ void PcapEditor::NodeEditorShow()
             {
                 int from, to;
                 if (ImNodes::IsLinkCreated(&from, &to)) {
-
-                    do {
-                        Attribute *fromAttr, *toAttr;
-                        for (auto &node : this->m_nodes) {
-                            for (auto &attribute : node->getAttributes()) {
-                                if (attribute.getId() == from)
-                                    fromAttr = &attribute;
-                                else if (attribute.getId() == to)
-                                    toAttr = &attribute;
-                            }
-                        }
-
-                        if (fromAttr == nullptr || toAttr == nullptr)
-                            break;
-
-                        if (fromAttr->getType() != toAttr->getType())
-                            break;
-
-                        if (fromAttr->getIOType() == toAttr->getIOType())
-                            break;
-
-                        if (!toAttr->getConnectedAttributes().empty())
-                            break;
-
-                        auto newLink = this->m_links.emplace_back(from, to);
-
-                        fromAttr->addConnectedAttribute(newLink.getId(), toAttr);
-                        toAttr->addConnectedAttribute(newLink.getId(), fromAttr);
-                    } while (false);
+                    if (this->m_graph.addLink(from, to) != nullptr)
+                        this->m_graphChanged = true;
                 }
             }
 
@@ -308,58 +553,11 @@ void PcapEditor::NodeEditorShow()
                     this->eraseNodes(selectedNodes);
                 }
             }
+
+            this->submitGraphChanges();
         }
         ImGui::End();
 }
-void PcapEditor::processNodes() {
-        // std::printf("process enter!");
-        if (this->m_dataOverlays.size() != this->m_endNodes.size()) {
-            for (auto overlay : this->m_dataOverlays)
-                get()->deleteOverlay(overlay);
-                
-            this->m_dataOverlays.clear();
-
-            for (u32 i = 0; i < this->m_endNodes.size(); i++)
-                this->m_dataOverlays.push_back(get()->newOverlay());
-                
-
-
-            u32 overlayIndex = 0;
-            for (auto endNode : this->m_endNodes) {
-                endNode->setCurrentOverlay(this->m_dataOverlays[overlayIndex]);
-                overlayIndex++;
-            }
-        }
-
-        this->m_currNodeError.reset();
-        // std::printf("process set endNote!");
-
-        try {
-            for (auto &endNode : this->m_endNodes) {
-                endNode->resetOutputData();
-
-                for (auto &node : this->m_nodes)
-                    node->resetProcessedInputs();
-
-                endNode->process();
-                
-            }
-        } catch (Node::NodeError &e) {
-            this->m_currNodeError = e;
-
-            for (auto overlay : this->m_dataOverlays)
-                get()->deleteOverlay(overlay);
-                
-            this->m_dataOverlays.clear();
-
-        } catch (std::runtime_error &e) {
-            std::printf("Node implementation bug! %s\n", e.what());
-        } catch(...)
-        {
-            std::cout<<"*******unknown error occurs!!!!********"<<std::endl;
-        }
-    }
-
 void PcapEditor::NodeEditorShutdown()
 {
     ImNodes::PopAttributeFlag();
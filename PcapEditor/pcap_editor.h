@@ -5,14 +5,16 @@
 #include <SDL_scancode.h>
 
 #include <algorithm>
-#include <list>
 #include <string>
 #include <concepts>
+#include <unordered_map>
 
 
 #include <link.hpp>
 #include <node.hpp>
 #include <attribute.hpp>
+#include <evaluator.hpp>
+#include <graph_registry.hpp>
 
 namespace PcapEditor
 {   
@@ -28,31 +30,51 @@ namespace PcapEditor
 
     class PcapEditor : public Editor{
     public:
-        PcapEditor(const char* editor_name):name(editor_name){};
+        PcapEditor(const char* editor_name):name(editor_name){ this->setGraphPath(DefaultGraphPath); };
         virtual void NodeEditorInitialize();
         virtual void NodeEditorShow();
         virtual void NodeEditorShutdown();
-    private:
 
-        std::list<Node *> m_endNodes;
-        std::list<Node *> m_nodes;
-        std::list<Link> m_links;
+        // Loads the graph on the first frame, Save then writes back to it
+        void loadGraphOnStart(const std::string &path);
+    private:
 
-        std::vector<Overlay *> m_dataOverlays;
+        GraphRegistry m_graph;
 
         int m_rightClickedId = -1;
         ImVec2 m_rightClickedCoords;
-        using NodeError = std::pair<Node *, std::string>;
-        std::optional<Node::NodeError> m_currNodeError;
+        // Nodes selected when the context menu opened, opening it clears the selection
+        std::vector<int> m_menuSelection;
 
         bool m_continuousEvaluation = false;
+        float m_tickRate = TickScheduler::DefaultRate;
+        int m_tickPolicy = 0;
+
+        static constexpr auto ProfileExportPath = "node_profile.json";
+        static constexpr auto DefaultGraphPath  = "graph.pceg";
+
+        std::string m_graphPath;
+        std::string m_graphFileStatus;
+        bool m_loadGraphOnStart = false;
+
+        Evaluator m_evaluator;
+        EvaluationResult m_evaluationResult;
+        bool m_graphChanged = false;
+        std::vector<Node *> m_erasedNodes;
+        std::vector<std::pair<u64, Node *>> m_retiredNodes;
+        std::unordered_map<u32, ImVec2> m_nodeContentSizes;
 
         void eraseLink(u32 id);
         void eraseNodes(const std::vector<int> &ids);
-        void processNodes();
-
-        // std::string saveNodes();
-        // void loadNodes(const std::string &data)
+        void groupNodes(const std::vector<int> &ids);
+        void expandGroup(u32 id);
+        void drawNodeContent(Node *node);
+        void submitGraphChanges();
+
+        // Paths ending in .json are saved as JSON, everything else in the binary format. Loading detects the format.
+        void setGraphPath(const std::string &path);
+        void saveGraph();
+        void loadGraph();
 
         std::string name;
         ImNodesEditorContext* context = nullptr;
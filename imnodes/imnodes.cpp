@@ -35,12 +35,6 @@ namespace
 {
 // [SECTION] bezier curve helpers
 
-struct CubicBezier
-{
-    ImVec2 P0, P1, P2, P3;
-    int    NumSegments;
-};
-
 inline ImVec2 EvalCubicBezier(
     const float   t,
     const ImVec2& P0,
@@ -60,56 +54,34 @@ inline ImVec2 EvalCubicBezier(
         b0 * P0.y + b1 * P1.y + b2 * P2.y + b3 * P3.y);
 }
 
-// Calculates the closest point along each bezier curve segment.
-ImVec2 GetClosestPointOnCubicBezier(const int num_segments, const ImVec2& p, const CubicBezier& cb)
+// Calculates the closest point along each segment of the tessellated curve.
+ImVec2 GetClosestPointOnPolyline(const ImVector<ImVec2>& points, const ImVec2& p)
 {
-    IM_ASSERT(num_segments > 0);
-    ImVec2 p_last = cb.P0;
+    IM_ASSERT(points.Size > 1);
     ImVec2 p_closest;
     float  p_closest_dist = FLT_MAX;
-    float  t_step = 1.0f / (float)num_segments;
-    for (int i = 1; i <= num_segments; ++i)
+    for (int i = 1; i < points.Size; ++i)
     {
-        ImVec2 p_current = EvalCubicBezier(t_step * i, cb.P0, cb.P1, cb.P2, cb.P3);
-        ImVec2 p_line = ImLineClosestPoint(p_last, p_current, p);
+        ImVec2 p_line = ImLineClosestPoint(points[i - 1], points[i], p);
         float  dist = ImLengthSqr(p - p_line);
         if (dist < p_closest_dist)
         {
             p_closest = p_line;
             p_closest_dist = dist;
         }
-        p_last = p_current;
     }
     return p_closest;
 }
 
-inline float GetDistanceToCubicBezier(
-    const ImVec2&      pos,
-    const CubicBezier& cubic_bezier,
-    const int          num_segments)
+inline float GetDistanceToPolyline(const ImVec2& pos, const ImVector<ImVec2>& points)
 {
-    const ImVec2 point_on_curve = GetClosestPointOnCubicBezier(num_segments, pos, cubic_bezier);
+    const ImVec2 point_on_curve = GetClosestPointOnPolyline(points, pos);
 
     const ImVec2 to_curve = point_on_curve - pos;
     return ImSqrt(ImLengthSqr(to_curve));
 }
 
-inline ImRect GetContainingRectForCubicBezier(const CubicBezier& cb)
-{
-    const ImVec2 min = ImVec2(ImMin(cb.P0.x, cb.P3.x), ImMin(cb.P0.y, cb.P3.y));
-    const ImVec2 max = ImVec2(ImMax(cb.P0.x, cb.P3.x), ImMax(cb.P0.y, cb.P3.y));
-
-    const float hover_distance = GImNodes->Style.LinkHoverDistance;
-
-    ImRect rect(min, max);
-    rect.Add(cb.P1);
-    rect.Add(cb.P2);
-    rect.Expand(ImVec2(hover_distance, hover_distance));
-
-    return rect;
-}
-
-inline CubicBezier GetCubicBezier(
+inline ImCubicBezier GetCubicBezier(
     ImVec2                     start,
     ImVec2                     end,
     const ImNodesAttributeType start_type,
@@ -124,7 +96,7 @@ inline CubicBezier GetCubicBezier(
 
     const float  link_length = ImSqrt(ImLengthSqr(end - start));
     const ImVec2 offset = ImVec2(0.25f * link_length, 0.f);
-    CubicBezier  cubic_bezier;
+    ImCubicBezier  cubic_bezier;
     cubic_bezier.P0 = start;
     cubic_bezier.P1 = start + offset;
     cubic_bezier.P2 = end - offset;
@@ -133,6 +105,71 @@ inline CubicBezier GetCubicBezier(
     return cubic_bezier;
 }
 
+// Contains the curve GetCubicBezier() makes between the two points, without computing it
+inline ImRect GetCubicBezierBounds(const ImVec2& start, const ImVec2& end)
+{
+    const float link_length = ImSqrt(ImLengthSqr(end - start));
+
+    ImRect rect(ImMin(start, end), ImMax(start, end));
+    rect.Expand(ImVec2(0.25f * link_length, 0.f));
+    return rect;
+}
+
+// Returns the curve from start to end, recomputing it only when the pins moved relative to each
+// other. Moving both by the same amount, as panning does, only translates the cached curve.
+const ImLinkGeometry& UpdateLinkGeometry(
+    ImLinkGeometry&            geometry,
+    const ImVec2&              start,
+    const ImVec2&              end,
+    const ImNodesAttributeType start_type,
+    const float                segments_per_length)
+{
+    if (geometry.StartType == start_type && geometry.SegmentsPerLength == segments_per_length &&
+        geometry.EndPos.x - geometry.StartPos.x == end.x - start.x &&
+        geometry.EndPos.y - geometry.StartPos.y == end.y - start.y)
+    {
+        const ImVec2 delta = start - geometry.StartPos;
+        if (delta.x != 0.0f || delta.y != 0.0f)
+        {
+            geometry.StartPos = start;
+            geometry.EndPos = end;
+            geometry.Bezier.P0 += delta;
+            geometry.Bezier.P1 += delta;
+            geometry.Bezier.P2 += delta;
+            geometry.Bezier.P3 += delta;
+            geometry.Rect.Translate(delta);
+            for (int i = 0; i < geometry.Points.Size; ++i)
+            {
+                geometry.Points[i] += delta;
+            }
+        }
+        return geometry;
+    }
+
+    const ImCubicBezier& cb = geometry.Bezier =
+        GetCubicBezier(start, end, start_type, segments_per_length);
+
+    geometry.StartPos = start;
+    geometry.EndPos = end;
+    geometry.StartType = start_type;
+    geometry.SegmentsPerLength = segments_per_length;
+
+    geometry.Rect = ImRect(
+        ImVec2(ImMin(cb.P0.x, cb.P3.x), ImMin(cb.P0.y, cb.P3.y)),
+        ImVec2(ImMax(cb.P0.x, cb.P3.x), ImMax(cb.P0.y, cb.P3.y)));
+    geometry.Rect.Add(cb.P1);
+    geometry.Rect.Add(cb.P2);
+
+    geometry.Points.resize(cb.NumSegments + 1);
+    const float t_step = 1.0f / (float)cb.NumSegments;
+    for (int i = 0; i <= cb.NumSegments; ++i)
+    {
+        geometry.Points[i] = EvalCubicBezier(t_step * i, cb.P0, cb.P1, cb.P2, cb.P3);
+    }
+
+    return geometry;
+}
+
 inline float EvalImplicitLineEq(const ImVec2& p1, const ImVec2& p2, const ImVec2& p)
 {
     return (p2.y - p1.y) * p.x + (p1.x - p2.x) * p.y + (p2.x * p1.y - p1.x * p2.y);
@@ -189,53 +226,27 @@ inline bool RectangleOverlapsLineSegment(const ImRect& rect, const ImVec2& p1, c
     return abs(sum) != sum_abs;
 }
 
-inline bool RectangleOverlapsBezier(const ImRect& rectangle, const CubicBezier& cubic_bezier)
+inline bool RectangleOverlapsPolyline(const ImRect& rectangle, const ImVector<ImVec2>& points)
 {
-    ImVec2 current =
-        EvalCubicBezier(0.f, cubic_bezier.P0, cubic_bezier.P1, cubic_bezier.P2, cubic_bezier.P3);
-    const float dt = 1.0f / cubic_bezier.NumSegments;
-    for (int s = 0; s < cubic_bezier.NumSegments; ++s)
+    for (int i = 1; i < points.Size; ++i)
     {
-        ImVec2 next = EvalCubicBezier(
-            static_cast<float>((s + 1) * dt),
-            cubic_bezier.P0,
-            cubic_bezier.P1,
-            cubic_bezier.P2,
-            cubic_bezier.P3);
-        if (RectangleOverlapsLineSegment(rectangle, current, next))
+        if (RectangleOverlapsLineSegment(rectangle, points[i - 1], points[i]))
         {
             return true;
         }
-        current = next;
     }
     return false;
 }
 
-inline bool RectangleOverlapsLink(
-    const ImRect&              rectangle,
-    const ImVec2&              start,
-    const ImVec2&              end,
-    const ImNodesAttributeType start_type)
+inline bool RectangleOverlapsLink(const ImRect& rectangle, const ImLinkGeometry& geometry)
 {
-    // First level: simple rejection test via rectangle overlap:
-
-    ImRect lrect = ImRect(start, end);
-    if (lrect.Min.x > lrect.Max.x)
-    {
-        ImSwap(lrect.Min.x, lrect.Max.x);
-    }
-
-    if (lrect.Min.y > lrect.Max.y)
-    {
-        ImSwap(lrect.Min.y, lrect.Max.y);
-    }
-
-    if (rectangle.Overlaps(lrect))
+    // First level: simple rejection test against the rectangle containing the curve
+    if (rectangle.Overlaps(geometry.Rect))
     {
         // First, check if either one or both endpoinds are trivially contained
         // in the rectangle
 
-        if (rectangle.Contains(start) || rectangle.Contains(end))
+        if (rectangle.Contains(geometry.StartPos) || rectangle.Contains(geometry.EndPos))
         {
             return true;
         }
@@ -243,9 +254,7 @@ inline bool RectangleOverlapsLink(
         // Second level of refinement: do a more expensive test against the
         // link
 
-        const CubicBezier cubic_bezier =
-            GetCubicBezier(start, end, start_type, GImNodes->Style.LinkLineSegmentsPerLength);
-        return RectangleOverlapsBezier(rectangle, cubic_bezier);
+        return RectangleOverlapsPolyline(rectangle, geometry.Points);
     }
 
     return false;
@@ -255,7 +264,7 @@ inline bool RectangleOverlapsLink(
 
 inline ImVec2 ScreenSpaceToGridSpace(const ImNodesEditorContext& editor, const ImVec2& v)
 {
-    return v - GImNodes->CanvasOriginScreenSpace - editor.Panning;
+    return (v - GImNodes->CanvasOriginScreenSpace - editor.Panning) / editor.Zoom;
 }
 
 inline ImRect ScreenSpaceToGridSpace(const ImNodesEditorContext& editor, const ImRect& r)
@@ -265,17 +274,17 @@ inline ImRect ScreenSpaceToGridSpace(const ImNodesEditorContext& editor, const I
 
 inline ImVec2 GridSpaceToScreenSpace(const ImNodesEditorContext& editor, const ImVec2& v)
 {
-    return v + GImNodes->CanvasOriginScreenSpace + editor.Panning;
+    return v * editor.Zoom + GImNodes->CanvasOriginScreenSpace + editor.Panning;
 }
 
 inline ImVec2 GridSpaceToEditorSpace(const ImNodesEditorContext& editor, const ImVec2& v)
 {
-    return v + editor.Panning;
+    return v * editor.Zoom + editor.Panning;
 }
 
 inline ImVec2 EditorSpaceToGridSpace(const ImNodesEditorContext& editor, const ImVec2& v)
 {
-    return v - editor.Panning;
+    return (v - editor.Panning) / editor.Zoom;
 }
 
 inline ImVec2 EditorSpaceToScreenSpace(const ImVec2& v)
@@ -386,11 +395,63 @@ void ImDrawListSplitterSwapChannels(
     }
 }
 
+// The draw channels and their buffers stay allocated for the next frames. The channels past the
+// peak are freed once less than half of them were used for a while, a graph that grows back soon
+// doesn't have to allocate them again. The editor counts the frames for the canvas draw list it was
+// last drawn into, editors taking turns on one draw list start over and don't trim it.
+void DrawListTrimChannels(ImNodesEditorContext& editor, const int channel_count)
+{
+    const int trim_after_frames = 60;
+
+    ImDrawListSplitter& splitter = GImNodes->CanvasDrawList->_Splitter;
+    // Called after merging, the first channel is a copy of the draw list's own buffers
+    assert(splitter._Count == 1 && splitter._Current == 0);
+
+    if (editor.ChannelTrimDrawList != GImNodes->CanvasDrawList ||
+        2 * channel_count >= splitter._Channels.Size)
+    {
+        editor.ChannelTrimDrawList = GImNodes->CanvasDrawList;
+        editor.ChannelUnderuseFrames = 0;
+        editor.ChannelPeakCount = 0;
+        return;
+    }
+
+    editor.ChannelPeakCount = ImMax(editor.ChannelPeakCount, channel_count);
+    if (++editor.ChannelUnderuseFrames < trim_after_frames)
+    {
+        return;
+    }
+
+    // Plus the two channels a node outside of the canvas holds until EndNode()
+    const int capacity = editor.ChannelPeakCount + 2;
+    for (int i = capacity; i < splitter._Channels.Size; ++i)
+    {
+        splitter._Channels[i]._CmdBuffer.clear();
+        splitter._Channels[i]._IdxBuffer.clear();
+    }
+
+    // ImVector doesn't shrink its storage, move the remaining channels' buffers into a smaller one.
+    // The old array is freed without destructing its channels, they're all empty after the swaps.
+    ImVector<ImDrawChannel> channels;
+    channels.reserve(capacity);
+    channels.resize(capacity, ImDrawChannel());
+    for (int i = 0; i < capacity; ++i)
+    {
+        channels[i]._CmdBuffer.swap(splitter._Channels[i]._CmdBuffer);
+        channels[i]._IdxBuffer.swap(splitter._Channels[i]._IdxBuffer);
+    }
+    splitter._Channels.swap(channels);
+
+    editor.ChannelUnderuseFrames = 0;
+    editor.ChannelPeakCount = 0;
+}
+
 void DrawListSet(ImDrawList* window_draw_list)
 {
     GImNodes->CanvasDrawList = window_draw_list;
-    GImNodes->NodeIdxToSubmissionIdx.Clear();
-    GImNodes->NodeIdxSubmissionOrder.clear();
+    // Keep the storage for the next frame
+    GImNodes->NodeIdxToSubmissionIdx.Data.resize(0);
+    GImNodes->NodeIdxSubmissionOrder.resize(0);
 }
 
 // The draw list channels are structured as follows. First we have our base channel, the canvas grid
@@ -399,7 +460,8 @@ void DrawListSet(ImDrawList* window_draw_list)
 // call appends two new draw channels, for the node background and foreground. The node foreground
 // is the channel into which the node's ImGui content is rendered. Finally, in EndNodeEditor() we
 // append one last draw channel for rendering the selection box and the incomplete link on top of
-// everything else.
+// everything else. A node found outside of the canvas in EndNode() gives its two channels back, the
+// next node reuses them.
 //
 // +----------+----------+----------+----------+----------+----------+
 // |          |          |          |          |          |          |
@@ -414,12 +476,30 @@ void DrawListSet(ImDrawList* window_draw_list)
 
 void DrawListAddNode(const int node_idx)
 {
-    GImNodes->NodeIdxToSubmissionIdx.SetInt(
-        static_cast<ImGuiID>(node_idx), GImNodes->NodeIdxSubmissionOrder.Size);
     GImNodes->NodeIdxSubmissionOrder.push_back(node_idx);
     ImDrawListGrowChannels(GImNodes->CanvasDrawList, 2);
 }
 
+void DrawListEndNode(const bool visible)
+{
+    if (visible)
+    {
+        const int submission_idx = GImNodes->NodeIdxSubmissionOrder.Size - 1;
+        GImNodes->NodeIdxToSubmissionIdx.SetInt(
+            static_cast<ImGuiID>(GImNodes->NodeIdxSubmissionOrder[submission_idx]),
+            submission_idx);
+        return;
+    }
+
+    // Whatever the node's content drew is outside of the canvas. The node's channels are the last
+    // two, drawing continues in the channel before them.
+    ImDrawList*         draw_list = GImNodes->CanvasDrawList;
+    ImDrawListSplitter& splitter = draw_list->_Splitter;
+    splitter.SetCurrentChannel(draw_list, splitter._Count - 3);
+    splitter._Count -= 2;
+    GImNodes->NodeIdxSubmissionOrder.pop_back();
+}
+
 void DrawListAppendClickInteractionChannel()
 {
     // NOTE: don't use this function outside of EndNodeEditor. Using this before all nodes have been
@@ -495,69 +575,90 @@ void DrawListSortChannelsByDepth(const ImVector<int>& node_idx_depth_order)
         return;
     }
 
-    assert(node_idx_depth_order.Size == GImNodes->NodeIdxSubmissionOrder.Size);
-
-    int start_idx = node_idx_depth_order.Size - 1;
-
-    while (node_idx_depth_order[start_idx] == GImNodes->NodeIdxSubmissionOrder[start_idx])
+    // The node at each depth takes the channels of the submission index it's found at. Nodes
+    // without channels keep their depth but have nothing to move.
+    ImVector<int>& depth_to_submission_idx = GImNodes->DepthToSubmissionIdx;
+    depth_to_submission_idx.resize(0);
+    bool in_submission_order = true;
+    for (int depth_idx = 0; depth_idx < node_idx_depth_order.Size; ++depth_idx)
     {
-        if (--start_idx == 0)
+        const int submission_idx = GImNodes->NodeIdxToSubmissionIdx.GetInt(
+            static_cast<ImGuiID>(node_idx_depth_order[depth_idx]), -1);
+        if (submission_idx != -1)
         {
-            // early out if submission order and depth order are the same
-            return;
+            in_submission_order &= submission_idx == depth_to_submission_idx.Size;
+            GImNodes->NodeIdxSubmissionOrder[depth_to_submission_idx.Size] =
+                node_idx_depth_order[depth_idx];
+            depth_to_submission_idx.push_back(submission_idx);
         }
     }
+    assert(depth_to_submission_idx.Size == GImNodes->NodeIdxSubmissionOrder.Size);
 
-    // TODO: this is an O(N^2) algorithm. It might be worthwhile revisiting this to see if the time
-    // complexity can be reduced.
-
-    for (int depth_idx = start_idx; depth_idx > 0; --depth_idx)
+    if (in_submission_order)
     {
-        const int node_idx = node_idx_depth_order[depth_idx];
-
-        // Find the current index of the node_idx in the submission order array
-        int submission_idx = -1;
-        for (int i = 0; i < GImNodes->NodeIdxSubmissionOrder.Size; ++i)
-        {
-            if (GImNodes->NodeIdxSubmissionOrder[i] == node_idx)
-            {
-                submission_idx = i;
-                break;
-            }
-        }
-        assert(submission_idx >= 0);
-
-        if (submission_idx == depth_idx)
-        {
-            continue;
-        }
+        // early out if submission order and depth order are the same
+        return;
+    }
 
-        for (int j = submission_idx; j < depth_idx; ++j)
+    // Apply the permutation one cycle at a time. Each swap moves one node's channels into their
+    // final place, so no more than one swap per node is needed. Placed nodes are marked by pointing
+    // their entry at themselves.
+    for (int depth_idx = 0; depth_idx < depth_to_submission_idx.Size; ++depth_idx)
+    {
+        int idx = depth_idx;
+        while (depth_to_submission_idx[idx] != depth_idx)
         {
-            DrawListSwapSubmissionIndices(j, j + 1);
-            ImSwap(GImNodes->NodeIdxSubmissionOrder[j], GImNodes->NodeIdxSubmissionOrder[j + 1]);
+            const int source_idx = depth_to_submission_idx[idx];
+            DrawListSwapSubmissionIndices(idx, source_idx);
+            depth_to_submission_idx[idx] = idx;
+            idx = source_idx;
         }
+        depth_to_submission_idx[idx] = idx;
     }
 }
 
 // [SECTION] ui state logic
 
 ImVec2 GetScreenSpacePinCoordinates(
-    const ImRect&              node_rect,
-    const ImRect&              attribute_rect,
-    const ImNodesAttributeType type)
+    const ImNodesEditorContext& editor,
+    const ImRect&               node_rect,
+    const ImRect&               attribute_rect,
+    const ImNodesAttributeType  type)
 {
     assert(type == ImNodesAttributeType_Input || type == ImNodesAttributeType_Output);
-    const float x = type == ImNodesAttributeType_Input
-                        ? (node_rect.Min.x - GImNodes->Style.PinOffset)
-                        : (node_rect.Max.x + GImNodes->Style.PinOffset);
+    const float pin_offset = GImNodes->Style.PinOffset * editor.Zoom;
+    const float x = type == ImNodesAttributeType_Input ? (node_rect.Min.x - pin_offset)
+                                                       : (node_rect.Max.x + pin_offset);
     return ImVec2(x, 0.5f * (attribute_rect.Min.y + attribute_rect.Max.y));
 }
 
 ImVec2 GetScreenSpacePinCoordinates(const ImNodesEditorContext& editor, const ImPinData& pin)
 {
     const ImRect& parent_node_rect = editor.Nodes.Pool[pin.ParentNodeIdx].Rect;
-    return GetScreenSpacePinCoordinates(parent_node_rect, pin.AttributeRect, pin.Type);
+    return GetScreenSpacePinCoordinates(editor, parent_node_rect, pin.AttributeRect, pin.Type);
+}
+
+// Links are sampled by their length on screen. Zoomed out below LinkDetailZoom, they get fewer
+// segments for their length as well.
+float GetLinkSegmentsPerLength(const ImNodesEditorContext& editor)
+{
+    const float segments_per_length = GImNodes->Style.LinkLineSegmentsPerLength;
+    return editor.Zoom < GImNodes->Style.LinkDetailZoom
+               ? segments_per_length * editor.Zoom / GImNodes->Style.LinkDetailZoom
+               : segments_per_length;
+}
+
+const ImLinkGeometry& GetLinkGeometry(ImNodesEditorContext& editor, const int link_idx)
+{
+    ImLinkData&      link = editor.Links.Pool[link_idx];
+    const ImPinData& start_pin = editor.Pins.Pool[link.StartPinIdx];
+    const ImPinData& end_pin = editor.Pins.Pool[link.EndPinIdx];
+    return UpdateLinkGeometry(
+        link.Geometry,
+        start_pin.Pos,
+        end_pin.Pos,
+        start_pin.Type,
+        GetLinkSegmentsPerLength(editor));
 }
 
 bool MouseInCanvas()
@@ -618,6 +719,8 @@ void BeginLinkDetach(ImNodesEditorContext& editor, const int link_idx, const int
     state.LinkCreation.EndPinIdx.Reset();
     state.LinkCreation.StartPinIdx =
         detach_pin_idx == link.StartPinIdx ? link.EndPinIdx : link.StartPinIdx;
+    state.LinkCreation.StartPinGeneration =
+        editor.Pins.Generations[state.LinkCreation.StartPinIdx];
     GImNodes->DeletedLinkIdx = link_idx;
 }
 
@@ -625,6 +728,8 @@ void BeginLinkCreation(ImNodesEditorContext& editor, const int hovered_pin_idx)
 {
     editor.ClickInteraction.Type = ImNodesClickInteractionType_LinkCreation;
     editor.ClickInteraction.LinkCreation.StartPinIdx = hovered_pin_idx;
+    editor.ClickInteraction.LinkCreation.StartPinGeneration =
+        editor.Pins.Generations[hovered_pin_idx];
     editor.ClickInteraction.LinkCreation.EndPinIdx.Reset();
     editor.ClickInteraction.LinkCreation.Type = ImNodesLinkCreationType_Standard;
     GImNodes->ImNodesUIState |= ImNodesUIState_LinkStarted;
@@ -728,17 +833,23 @@ void BoxSelectorUpdateSelection(ImNodesEditorContext& editor, ImRect box_rect)
 
     editor.SelectedNodeIndices.clear();
 
-    // Test for overlap against node rectangles
+    // Test for overlap against the rectangles of the nodes near the box. They were placed in the
+    // grid before this frame's auto panning moved the box.
 
-    for (int node_idx = 0; node_idx < editor.Nodes.Pool.size(); ++node_idx)
+    ImRect grid_box_rect = ScreenSpaceToGridSpace(editor, box_rect);
+    grid_box_rect.Translate(editor.AutoPanningDelta / editor.Zoom);
+    SpatialGridQuery(editor.NodeGrid, grid_box_rect, editor.SelectedNodeIndices);
+
+    for (int i = 0; i < editor.SelectedNodeIndices.size();)
     {
-        if (editor.Nodes.InUse[node_idx])
+        const int node_idx = editor.SelectedNodeIndices[i];
+        if (editor.Nodes.InUse[node_idx] && box_rect.Overlaps(editor.Nodes.Pool[node_idx].Rect))
         {
-            ImNodeData& node = editor.Nodes.Pool[node_idx];
-            if (box_rect.Overlaps(node.Rect))
-            {
-                editor.SelectedNodeIndices.push_back(node_idx);
-            }
+            ++i;
+        }
+        else
+        {
+            editor.SelectedNodeIndices.erase_unsorted(editor.SelectedNodeIndices.begin() + i);
         }
     }
 
@@ -752,20 +863,8 @@ void BoxSelectorUpdateSelection(ImNodesEditorContext& editor, ImRect box_rect)
     {
         if (editor.Links.InUse[link_idx])
         {
-            const ImLinkData& link = editor.Links.Pool[link_idx];
-
-            const ImPinData& pin_start = editor.Pins.Pool[link.StartPinIdx];
-            const ImPinData& pin_end = editor.Pins.Pool[link.EndPinIdx];
-            const ImRect&    node_start_rect = editor.Nodes.Pool[pin_start.ParentNodeIdx].Rect;
-            const ImRect&    node_end_rect = editor.Nodes.Pool[pin_end.ParentNodeIdx].Rect;
-
-            const ImVec2 start = GetScreenSpacePinCoordinates(
-                node_start_rect, pin_start.AttributeRect, pin_start.Type);
-            const ImVec2 end =
-                GetScreenSpacePinCoordinates(node_end_rect, pin_end.AttributeRect, pin_end.Type);
-
             // Test
-            if (RectangleOverlapsLink(box_rect, start, end, pin_start.Type))
+            if (RectangleOverlapsLink(box_rect, GetLinkGeometry(editor, link_idx)))
             {
                 editor.SelectedLinkIndices.push_back(link_idx);
             }
@@ -784,7 +883,7 @@ void TranslateSelectedNodes(ImNodesEditorContext& editor)
             ImNodeData& node = editor.Nodes.Pool[node_idx];
             if (node.Draggable)
             {
-                node.Origin += io.MouseDelta - editor.AutoPanningDelta;
+                node.Origin += (io.MouseDelta - editor.AutoPanningDelta) / editor.Zoom;
             }
         }
     }
@@ -943,6 +1042,16 @@ void ClickInteractionUpdate(ImNodesEditorContext& editor)
     break;
     case ImNodesClickInteractionType_LinkCreation:
     {
+        // The start pin's node was removed while the link was being dragged out of it
+        if (!ObjectPoolIsCurrent(
+                editor.Pins,
+                editor.ClickInteraction.LinkCreation.StartPinIdx,
+                editor.ClickInteraction.LinkCreation.StartPinGeneration))
+        {
+            editor.ClickInteraction.Type = ImNodesClickInteractionType_None;
+            break;
+        }
+
         const ImPinData& start_pin =
             editor.Pins.Pool[editor.ClickInteraction.LinkCreation.StartPinIdx];
 
@@ -982,8 +1091,8 @@ void ClickInteractionUpdate(ImNodesEditorContext& editor)
                                          editor, editor.Pins.Pool[GImNodes->HoveredPinIdx.Value()])
                                    : GImNodes->MousePos;
 
-        const CubicBezier cubic_bezier = GetCubicBezier(
-            start_pos, end_pos, start_pin.Type, GImNodes->Style.LinkLineSegmentsPerLength);
+        const ImCubicBezier cubic_bezier =
+            GetCubicBezier(start_pos, end_pos, start_pin.Type, GetLinkSegmentsPerLength(editor));
 #if IMGUI_VERSION_NUM < 18000
         GImNodes->CanvasDrawList->AddBezierCurve(
 #else
@@ -994,7 +1103,7 @@ void ClickInteractionUpdate(ImNodesEditorContext& editor)
             cubic_bezier.P2,
             cubic_bezier.P3,
             GImNodes->Style.Colors[ImNodesCol_Link],
-            GImNodes->Style.LinkThickness,
+            GImNodes->Style.LinkThickness * editor.Zoom,
             cubic_bezier.NumSegments);
 
         const bool link_creation_on_snap =
@@ -1063,38 +1172,89 @@ void ClickInteractionUpdate(ImNodesEditorContext& editor)
     }
 }
 
-void ResolveOccludedPins(const ImNodesEditorContext& editor, ImVector<int>& occluded_pin_indices)
+// Returns whether the node is drawn above the other node
+bool IsNodeAbove(const ImVector<int>& depth_stack, const int node_idx, const int other_node_idx)
 {
-    const ImVector<int>& depth_stack = editor.NodeDepthOrder;
+    for (int depth_idx = depth_stack.Size - 1; depth_idx >= 0; --depth_idx)
+    {
+        if (depth_stack[depth_idx] == node_idx)
+        {
+            return true;
+        }
+
+        if (depth_stack[depth_idx] == other_node_idx)
+        {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+void FindPinsNearMouse(const ImNodesEditorContext& editor, ImVector<int>& pin_indices)
+{
+    pin_indices.resize(0);
+
+    const ImVec2 hover_radius(GImNodes->Style.PinHoverRadius, GImNodes->Style.PinHoverRadius);
+    SpatialGridQuery(
+        editor.PinGrid,
+        ScreenSpaceToGridSpace(
+            editor, ImRect(GImNodes->MousePos - hover_radius, GImNodes->MousePos + hover_radius)),
+        pin_indices);
+
+    // The grid holds the positions of pins that weren't submitted this frame until the pool update
+    const float hover_radius_sqr = GImNodes->Style.PinHoverRadius * GImNodes->Style.PinHoverRadius;
+    for (int i = 0; i < pin_indices.Size;)
+    {
+        const int pin_idx = pin_indices[i];
+        if (editor.Pins.InUse[pin_idx] &&
+            ImLengthSqr(editor.Pins.Pool[pin_idx].Pos - GImNodes->MousePos) < hover_radius_sqr)
+        {
+            ++i;
+        }
+        else
+        {
+            pin_indices.erase_unsorted(pin_indices.begin() + i);
+        }
+    }
+}
 
-    occluded_pin_indices.resize(0);
+// Only pins within hover range of the mouse can become hovered, so only those are tested against
+// the nodes drawn above them
+void ResolveOccludedPins(
+    const ImNodesEditorContext& editor,
+    const ImVector<int>&        pin_indices,
+    ImBitVector&                occluded_pins)
+{
+    occluded_pins.Create(editor.Pins.Pool.Size);
 
-    if (depth_stack.Size < 2)
+    if (editor.NodeDepthOrder.Size < 2)
     {
         return;
     }
 
-    // For each node in the depth stack
-    for (int depth_idx = 0; depth_idx < (depth_stack.Size - 1); ++depth_idx)
+    ImVector<int> nodes_at_pin;
+
+    for (int i = 0; i < pin_indices.Size; ++i)
     {
-        const ImNodeData& node_below = editor.Nodes.Pool[depth_stack[depth_idx]];
+        const int        pin_idx = pin_indices[i];
+        const ImPinData& pin = editor.Pins.Pool[pin_idx];
 
-        // Iterate over the rest of the depth stack to find nodes overlapping the pins
-        for (int next_depth_idx = depth_idx + 1; next_depth_idx < depth_stack.Size;
-             ++next_depth_idx)
-        {
-            const ImRect& rect_above = editor.Nodes.Pool[depth_stack[next_depth_idx]].Rect;
+        nodes_at_pin.resize(0);
+        SpatialGridQuery(
+            editor.NodeGrid,
+            ScreenSpaceToGridSpace(editor, ImRect(pin.Pos, pin.Pos)),
+            nodes_at_pin);
 
-            // Iterate over each pin
-            for (int idx = 0; idx < node_below.PinIndices.Size; ++idx)
+        for (int j = 0; j < nodes_at_pin.Size; ++j)
+        {
+            const int node_idx = nodes_at_pin[j];
+            if (node_idx != pin.ParentNodeIdx && editor.Nodes.InUse[node_idx] &&
+                editor.Nodes.Pool[node_idx].Rect.Contains(pin.Pos) &&
+                IsNodeAbove(editor.NodeDepthOrder, node_idx, pin.ParentNodeIdx))
             {
-                const int     pin_idx = node_below.PinIndices[idx];
-                const ImVec2& pin_pos = editor.Pins.Pool[pin_idx].Pos;
-
-                if (rect_above.Contains(pin_pos))
-                {
-                    occluded_pin_indices.push_back(pin_idx);
-                }
+                occluded_pins.SetBit(pin_idx);
+                break;
             }
         }
     }
@@ -1102,33 +1262,31 @@ void ResolveOccludedPins(const ImNodesEditorContext& editor, ImVector<int>& occl
 
 ImOptionalIndex ResolveHoveredPin(
     const ImObjectPool<ImPinData>& pins,
-    const ImVector<int>&           occluded_pin_indices)
+    const ImVector<int>&           pin_indices,
+    const ImBitVector&             occluded_pins)
 {
     float           smallest_distance = FLT_MAX;
     ImOptionalIndex pin_idx_with_smallest_distance;
 
-    const float hover_radius_sqr = GImNodes->Style.PinHoverRadius * GImNodes->Style.PinHoverRadius;
-
-    for (int idx = 0; idx < pins.Pool.Size; ++idx)
+    for (int i = 0; i < pin_indices.Size; ++i)
     {
-        if (!pins.InUse[idx])
-        {
-            continue;
-        }
+        const int idx = pin_indices[i];
 
-        if (occluded_pin_indices.contains(idx))
+        if (occluded_pins.TestBit(idx))
         {
             continue;
         }
 
-        const ImVec2& pin_pos = pins.Pool[idx].Pos;
-        const float   distance_sqr = ImLengthSqr(pin_pos - GImNodes->MousePos);
+        const float distance_sqr = ImLengthSqr(pins.Pool[idx].Pos - GImNodes->MousePos);
 
         // TODO: GImNodes->Style.PinHoverRadius needs to be copied into pin data and the pin-local
         // value used here. This is no longer called in BeginAttribute/EndAttribute scope and the
         // detected pin might have a different hover radius than what the user had when calling
         // BeginAttribute/EndAttribute.
-        if (distance_sqr < hover_radius_sqr && distance_sqr < smallest_distance)
+        //
+        // Ties go to the lower pin index, the order the pins used to be scanned in.
+        if (distance_sqr < smallest_distance ||
+            (distance_sqr == smallest_distance && idx < pin_idx_with_smallest_distance.Value()))
         {
             smallest_distance = distance_sqr;
             pin_idx_with_smallest_distance = idx;
@@ -1138,42 +1296,59 @@ ImOptionalIndex ResolveHoveredPin(
     return pin_idx_with_smallest_distance;
 }
 
-ImOptionalIndex ResolveHoveredNode(const ImVector<int>& depth_stack)
+ImOptionalIndex ResolveHoveredNode(const ImNodesEditorContext& editor)
 {
-    if (GImNodes->NodeIndicesOverlappingWithMouse.size() == 0)
+    ImVector<int>& overlapping_nodes = GImNodes->NodeIndicesOverlappingWithMouse;
+
+    overlapping_nodes.resize(0);
+
+    // The grid holds the rects of nodes that weren't submitted this frame until the pool update
+    SpatialGridQuery(
+        editor.NodeGrid,
+        ScreenSpaceToGridSpace(editor, ImRect(GImNodes->MousePos, GImNodes->MousePos)),
+        overlapping_nodes);
+    for (int i = 0; i < overlapping_nodes.size();)
     {
-        return ImOptionalIndex();
+        const int node_idx = overlapping_nodes[i];
+        if (editor.Nodes.InUse[node_idx] &&
+            editor.Nodes.Pool[node_idx].Rect.Contains(GImNodes->MousePos))
+        {
+            ++i;
+        }
+        else
+        {
+            overlapping_nodes.erase_unsorted(overlapping_nodes.begin() + i);
+        }
     }
 
-    if (GImNodes->NodeIndicesOverlappingWithMouse.size() == 1)
+    if (overlapping_nodes.size() == 0)
     {
-        return ImOptionalIndex(GImNodes->NodeIndicesOverlappingWithMouse[0]);
+        return ImOptionalIndex();
     }
 
-    int largest_depth_idx = -1;
-    int node_idx_on_top = -1;
+    if (overlapping_nodes.size() == 1)
+    {
+        return ImOptionalIndex(overlapping_nodes[0]);
+    }
 
-    for (int i = 0; i < GImNodes->NodeIndicesOverlappingWithMouse.size(); ++i)
+    // The first overlapping node from the top of the depth stack
+    const ImVector<int>& depth_stack = editor.NodeDepthOrder;
+    for (int depth_idx = depth_stack.size() - 1; depth_idx >= 0; --depth_idx)
     {
-        const int node_idx = GImNodes->NodeIndicesOverlappingWithMouse[i];
-        for (int depth_idx = 0; depth_idx < depth_stack.size(); ++depth_idx)
+        if (overlapping_nodes.contains(depth_stack[depth_idx]))
         {
-            if (depth_stack[depth_idx] == node_idx && (depth_idx > largest_depth_idx))
-            {
-                largest_depth_idx = depth_idx;
-                node_idx_on_top = node_idx;
-            }
+            return ImOptionalIndex(depth_stack[depth_idx]);
         }
     }
 
-    assert(node_idx_on_top != -1);
-    return ImOptionalIndex(node_idx_on_top);
+    assert(!"Overlapping node missing from the depth stack");
+    return ImOptionalIndex();
 }
 
-ImOptionalIndex ResolveHoveredLink(
-    const ImObjectPool<ImLinkData>& links,
-    const ImObjectPool<ImPinData>&  pins)
+ImOptionalIndex ResolveHoveredLink(ImNodesEditorContext& editor)
 {
+    const ImObjectPool<ImLinkData>& links = editor.Links;
+
     float           smallest_distance = FLT_MAX;
     ImOptionalIndex link_idx_with_smallest_distance;
 
@@ -1193,8 +1368,6 @@ ImOptionalIndex ResolveHoveredLink(
         }
 
         const ImLinkData& link = links.Pool[idx];
-        const ImPinData&  start_pin = pins.Pool[link.StartPinIdx];
-        const ImPinData&  end_pin = pins.Pool[link.EndPinIdx];
 
         // If there is a hovered pin links can only be considered hovered if they use that pin
         if (GImNodes->HoveredPinIdx.HasValue())
@@ -1207,22 +1380,28 @@ ImOptionalIndex ResolveHoveredLink(
             continue;
         }
 
-        // TODO: the calculated CubicBeziers could be cached since we generate them again when
-        // rendering the links
+        // Far away links are rejected before their curve is brought up to date
+        const float hover_distance = GImNodes->Style.LinkHoverDistance;
+        ImRect      link_bounds = GetCubicBezierBounds(
+            editor.Pins.Pool[link.StartPinIdx].Pos, editor.Pins.Pool[link.EndPinIdx].Pos);
+        link_bounds.Expand(ImVec2(hover_distance, hover_distance));
+        if (!link_bounds.Contains(GImNodes->MousePos))
+        {
+            continue;
+        }
 
-        const CubicBezier cubic_bezier = GetCubicBezier(
-            start_pin.Pos, end_pin.Pos, start_pin.Type, GImNodes->Style.LinkLineSegmentsPerLength);
+        const ImLinkGeometry& geometry = GetLinkGeometry(editor, idx);
 
         // The distance test
         {
-            const ImRect link_rect = GetContainingRectForCubicBezier(cubic_bezier);
+            ImRect link_rect = geometry.Rect;
+            link_rect.Expand(ImVec2(hover_distance, hover_distance));
 
             // First, do a simple bounding box test against the box containing the link
             // to see whether calculating the distance to the link is worth doing.
             if (link_rect.Contains(GImNodes->MousePos))
             {
-                const float distance = GetDistanceToCubicBezier(
-                    GImNodes->MousePos, cubic_bezier, cubic_bezier.NumSegments);
+                const float distance = GetDistanceToPolyline(GImNodes->MousePos, geometry.Points);
 
                 // TODO: GImNodes->Style.LinkHoverDistance could be also copied into ImLinkData,
                 // since we're not calling this function in the same scope as ImNodes::Link(). The
@@ -1244,16 +1423,18 @@ ImOptionalIndex ResolveHoveredLink(
 
 inline ImRect GetItemRect() { return ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax()); }
 
-inline ImVec2 GetNodeTitleBarOrigin(const ImNodeData& node)
+// The node's layout style is in screen space, these return editor space positions
+inline ImVec2 GetNodeTitleBarOrigin(const ImNodesEditorContext& editor, const ImNodeData& node)
 {
-    return node.Origin + node.LayoutStyle.Padding;
+    return GridSpaceToEditorSpace(editor, node.Origin) + node.LayoutStyle.Padding;
 }
 
-inline ImVec2 GetNodeContentOrigin(const ImNodeData& node)
+inline ImVec2 GetNodeContentOrigin(const ImNodesEditorContext& editor, const ImNodeData& node)
 {
     const ImVec2 title_bar_height =
         ImVec2(0.f, node.TitleBarContentRect.GetHeight() + 2.0f * node.LayoutStyle.Padding.y);
-    return node.Origin + title_bar_height + node.LayoutStyle.Padding;
+    return GridSpaceToEditorSpace(editor, node.Origin) + title_bar_height +
+           node.LayoutStyle.Padding;
 }
 
 inline ImRect GetNodeTitleRect(const ImNodeData& node)
@@ -1271,8 +1452,14 @@ void DrawGrid(ImNodesEditorContext& editor, const ImVec2& canvas_size)
 {
     const ImVec2 offset = editor.Panning;
 
-    for (float x = fmodf(offset.x, GImNodes->Style.GridSpacing); x < canvas_size.x;
-         x += GImNodes->Style.GridSpacing)
+    // Zoomed out, every other line is left out until they're at least half the spacing apart
+    float spacing = GImNodes->Style.GridSpacing * editor.Zoom;
+    while (spacing < 0.5f * GImNodes->Style.GridSpacing)
+    {
+        spacing *= 2.f;
+    }
+
+    for (float x = fmodf(offset.x, spacing); x < canvas_size.x; x += spacing)
     {
         GImNodes->CanvasDrawList->AddLine(
             EditorSpaceToScreenSpace(ImVec2(x, 0.0f)),
@@ -1280,8 +1467,7 @@ void DrawGrid(ImNodesEditorContext& editor, const ImVec2& canvas_size)
             GImNodes->Style.Colors[ImNodesCol_GridLine]);
     }
 
-    for (float y = fmodf(offset.y, GImNodes->Style.GridSpacing); y < canvas_size.y;
-         y += GImNodes->Style.GridSpacing)
+    for (float y = fmodf(offset.y, spacing); y < canvas_size.y; y += spacing)
     {
         GImNodes->CanvasDrawList->AddLine(
             EditorSpaceToScreenSpace(ImVec2(0.0f, y)),
@@ -1338,7 +1524,11 @@ TriangleOffsets CalculateTriangleOffsets(const float side_length)
     return offset;
 }
 
-void DrawPinShape(const ImVec2& pin_pos, const ImPinData& pin, const ImU32 pin_color)
+void DrawPinShape(
+    const ImVec2&    pin_pos,
+    const ImPinData& pin,
+    const ImU32      pin_color,
+    const float      zoom)
 {
     static const int CIRCLE_NUM_SEGMENTS = 8;
 
@@ -1348,33 +1538,33 @@ void DrawPinShape(const ImVec2& pin_pos, const ImPinData& pin, const ImU32 pin_c
     {
         GImNodes->CanvasDrawList->AddCircle(
             pin_pos,
-            GImNodes->Style.PinCircleRadius,
+            GImNodes->Style.PinCircleRadius * zoom,
             pin_color,
             CIRCLE_NUM_SEGMENTS,
-            GImNodes->Style.PinLineThickness);
+            GImNodes->Style.PinLineThickness * zoom);
     }
     break;
     case ImNodesPinShape_CircleFilled:
     {
         GImNodes->CanvasDrawList->AddCircleFilled(
-            pin_pos, GImNodes->Style.PinCircleRadius, pin_color, CIRCLE_NUM_SEGMENTS);
+            pin_pos, GImNodes->Style.PinCircleRadius * zoom, pin_color, CIRCLE_NUM_SEGMENTS);
     }
     break;
     case ImNodesPinShape_Quad:
     {
-        const QuadOffsets offset = CalculateQuadOffsets(GImNodes->Style.PinQuadSideLength);
+        const QuadOffsets offset = CalculateQuadOffsets(GImNodes->Style.PinQuadSideLength * zoom);
         GImNodes->CanvasDrawList->AddQuad(
             pin_pos + offset.TopLeft,
             pin_pos + offset.BottomLeft,
             pin_pos + offset.BottomRight,
             pin_pos + offset.TopRight,
             pin_color,
-            GImNodes->Style.PinLineThickness);
+            GImNodes->Style.PinLineThickness * zoom);
     }
     break;
     case ImNodesPinShape_QuadFilled:
     {
-        const QuadOffsets offset = CalculateQuadOffsets(GImNodes->Style.PinQuadSideLength);
+        const QuadOffsets offset = CalculateQuadOffsets(GImNodes->Style.PinQuadSideLength * zoom);
         GImNodes->CanvasDrawList->AddQuadFilled(
             pin_pos + offset.TopLeft,
             pin_pos + offset.BottomLeft,
@@ -1386,7 +1576,7 @@ void DrawPinShape(const ImVec2& pin_pos, const ImPinData& pin, const ImU32 pin_c
     case ImNodesPinShape_Triangle:
     {
         const TriangleOffsets offset =
-            CalculateTriangleOffsets(GImNodes->Style.PinTriangleSideLength);
+            CalculateTriangleOffsets(GImNodes->Style.PinTriangleSideLength * zoom);
         GImNodes->CanvasDrawList->AddTriangle(
             pin_pos + offset.TopLeft,
             pin_pos + offset.BottomLeft,
@@ -1396,13 +1586,13 @@ void DrawPinShape(const ImVec2& pin_pos, const ImPinData& pin, const ImU32 pin_c
             // much thinner than the lines drawn by AddCircle or AddQuad.
             // Multiplying the line thickness by two seemed to solve the
             // problem at a few different thickness values.
-            2.f * GImNodes->Style.PinLineThickness);
+            2.f * GImNodes->Style.PinLineThickness * zoom);
     }
     break;
     case ImNodesPinShape_TriangleFilled:
     {
         const TriangleOffsets offset =
-            CalculateTriangleOffsets(GImNodes->Style.PinTriangleSideLength);
+            CalculateTriangleOffsets(GImNodes->Style.PinTriangleSideLength * zoom);
         GImNodes->CanvasDrawList->AddTriangleFilled(
             pin_pos + offset.TopLeft,
             pin_pos + offset.BottomLeft,
@@ -1418,10 +1608,7 @@ void DrawPinShape(const ImVec2& pin_pos, const ImPinData& pin, const ImU32 pin_c
 
 void DrawPin(ImNodesEditorContext& editor, const int pin_idx)
 {
-    ImPinData&    pin = editor.Pins.Pool[pin_idx];
-    const ImRect& parent_node_rect = editor.Nodes.Pool[pin.ParentNodeIdx].Rect;
-
-    pin.Pos = GetScreenSpacePinCoordinates(parent_node_rect, pin.AttributeRect, pin.Type);
+    const ImPinData& pin = editor.Pins.Pool[pin_idx];
 
     ImU32 pin_color = pin.ColorStyle.Background;
 
@@ -1430,13 +1617,13 @@ void DrawPin(ImNodesEditorContext& editor, const int pin_idx)
         pin_color = pin.ColorStyle.Hovered;
     }
 
-    DrawPinShape(pin.Pos, pin, pin_color);
+    DrawPinShape(pin.Pos, pin, pin_color, editor.Zoom);
 }
 
 void DrawNode(ImNodesEditorContext& editor, const int node_idx)
 {
     const ImNodeData& node = editor.Nodes.Pool[node_idx];
-    ImGui::SetCursorPos(node.Origin + editor.Panning);
+    ImGui::SetCursorPos(GridSpaceToEditorSpace(editor, node.Origin));
 
     const bool node_hovered =
         GImNodes->HoveredNodeIdx == node_idx &&
@@ -1456,6 +1643,12 @@ void DrawNode(ImNodesEditorContext& editor, const int node_idx)
         titlebar_background = node.ColorStyle.TitlebarHovered;
     }
 
+    if (editor.Zoom < GImNodes->Style.NodeDetailZoom)
+    {
+        // Too small for details, the node's content was clipped away when it was submitted
+        GImNodes->CanvasDrawList->AddRectFilled(node.Rect.Min, node.Rect.Max, node_background);
+    }
+    else
     {
         // node base
         GImNodes->CanvasDrawList->AddRectFilled(
@@ -1504,11 +1697,11 @@ void DrawNode(ImNodesEditorContext& editor, const int node_idx)
                 node.LayoutStyle.BorderThickness);
 #endif
         }
-    }
 
-    for (int i = 0; i < node.PinIndices.size(); ++i)
-    {
-        DrawPin(editor, node.PinIndices[i]);
+        for (int i = 0; i < node.PinIndices.size(); ++i)
+        {
+            DrawPin(editor, node.PinIndices[i]);
+        }
     }
 
     if (node_hovered)
@@ -1519,12 +1712,8 @@ void DrawNode(ImNodesEditorContext& editor, const int node_idx)
 
 void DrawLink(ImNodesEditorContext& editor, const int link_idx)
 {
-    const ImLinkData& link = editor.Links.Pool[link_idx];
-    const ImPinData&  start_pin = editor.Pins.Pool[link.StartPinIdx];
-    const ImPinData&  end_pin = editor.Pins.Pool[link.EndPinIdx];
-
-    const CubicBezier cubic_bezier = GetCubicBezier(
-        start_pin.Pos, end_pin.Pos, start_pin.Type, GImNodes->Style.LinkLineSegmentsPerLength);
+    const ImLinkData&     link = editor.Links.Pool[link_idx];
+    const ImLinkGeometry& geometry = GetLinkGeometry(editor, link_idx);
 
     const bool link_hovered =
         GImNodes->HoveredLinkIdx == link_idx &&
@@ -1555,18 +1744,12 @@ void DrawLink(ImNodesEditorContext& editor, const int link_idx)
         link_color = link.ColorStyle.Hovered;
     }
 
-#if IMGUI_VERSION_NUM < 18000
-    GImNodes->CanvasDrawList->AddBezierCurve(
-#else
-    GImNodes->CanvasDrawList->AddBezierCubic(
-#endif
-        cubic_bezier.P0,
-        cubic_bezier.P1,
-        cubic_bezier.P2,
-        cubic_bezier.P3,
+    GImNodes->CanvasDrawList->AddPolyline(
+        geometry.Points.Data,
+        geometry.Points.Size,
         link_color,
-        GImNodes->Style.LinkThickness,
-        cubic_bezier.NumSegments);
+        0,
+        GImNodes->Style.LinkThickness * editor.Zoom);
 }
 
 void BeginPinAttribute(
@@ -1624,11 +1807,14 @@ void Initialize(ImNodesContext* context)
 {
     context->CanvasOriginScreenSpace = ImVec2(0.0f, 0.0f);
     context->CanvasRectScreenSpace = ImRect(ImVec2(0.f, 0.f), ImVec2(0.f, 0.f));
+    context->NodeCullRectScreenSpace = ImRect(ImVec2(0.f, 0.f), ImVec2(0.f, 0.f));
     context->CurrentScope = ImNodesScope_None;
 
     context->CurrentPinIdx = INT_MAX;
     context->CurrentNodeIdx = INT_MAX;
 
+    context->FrameStatsTime = 0.0;
+
     context->DefaultEditorCtx = EditorContextCreate();
     EditorContextSet(GImNodes->DefaultEditorCtx);
 
@@ -1726,7 +1912,7 @@ static void MiniMapDrawNode(ImNodesEditorContext& editor, const int node_idx)
 
     // Round to near whole pixel value for corner-rounding to prevent visual glitches
     const float mini_map_node_rounding =
-        floorf(node.LayoutStyle.CornerRounding * editor.MiniMapScaling);
+        floorf(node.LayoutStyle.CornerRounding / editor.Zoom * editor.MiniMapScaling);
 
     ImU32 mini_map_node_background;
 
@@ -1761,15 +1947,9 @@ static void MiniMapDrawNode(ImNodesEditorContext& editor, const int node_idx)
 
 static void MiniMapDrawLink(ImNodesEditorContext& editor, const int link_idx)
 {
-    const ImLinkData& link = editor.Links.Pool[link_idx];
-    const ImPinData&  start_pin = editor.Pins.Pool[link.StartPinIdx];
-    const ImPinData&  end_pin = editor.Pins.Pool[link.EndPinIdx];
-
-    const CubicBezier cubic_bezier = GetCubicBezier(
-        ScreenSpaceToMiniMapSpace(editor, start_pin.Pos),
-        ScreenSpaceToMiniMapSpace(editor, end_pin.Pos),
-        start_pin.Type,
-        GImNodes->Style.LinkLineSegmentsPerLength / editor.MiniMapScaling);
+    // The mini-map only scales and translates the canvas, which maps the link's curve onto the
+    // mini-map's
+    const ImLinkGeometry& geometry = GetLinkGeometry(editor, link_idx);
 
     // It's possible for a link to be deleted in begin_link_interaction. A user
     // may detach a link, resulting in the link wire snapping to the mouse
@@ -1786,18 +1966,12 @@ static void MiniMapDrawLink(ImNodesEditorContext& editor, const int link_idx)
             [editor.SelectedLinkIndices.contains(link_idx) ? ImNodesCol_MiniMapLinkSelected
                                                            : ImNodesCol_MiniMapLink];
 
-#if IMGUI_VERSION_NUM < 18000
-    GImNodes->CanvasDrawList->AddBezierCurve(
-#else
-    GImNodes->CanvasDrawList->AddBezierCubic(
-#endif
-        cubic_bezier.P0,
-        cubic_bezier.P1,
-        cubic_bezier.P2,
-        cubic_bezier.P3,
-        link_color,
-        GImNodes->Style.LinkThickness * editor.MiniMapScaling,
-        cubic_bezier.NumSegments);
+    for (int i = 0; i < geometry.Points.Size; ++i)
+    {
+        GImNodes->CanvasDrawList->PathLineTo(ScreenSpaceToMiniMapSpace(editor, geometry.Points[i]));
+    }
+    GImNodes->CanvasDrawList->PathStroke(
+        link_color, 0, GImNodes->Style.LinkThickness * editor.MiniMapScaling);
 }
 
 static void MiniMapUpdate()
@@ -1869,12 +2043,12 @@ static void MiniMapUpdate()
 
     bool center_on_click = mini_map_is_hovered && ImGui::IsMouseDown(ImGuiMouseButton_Left) &&
                            editor.ClickInteraction.Type == ImNodesClickInteractionType_None &&
-                           !GImNodes->NodeIdxSubmissionOrder.empty();
+                           editor.Nodes.Pool.size() > editor.Nodes.FreeList.size();
     if (center_on_click)
     {
         ImVec2 target = MiniMapSpaceToGridSpace(editor, ImGui::GetMousePos());
         ImVec2 center = GImNodes->CanvasRectScreenSpace.GetSize() * 0.5f;
-        editor.Panning = ImFloor(center - target);
+        editor.Panning = ImFloor(center - target * editor.Zoom);
     }
 
     // Reset callback info after use
@@ -1912,6 +2086,23 @@ bool IsObjectSelected(const ImObjectPool<T>& objects, ImVector<int>& selected_in
     return selected_indices.find(idx) != selected_indices.end();
 }
 
+// [SECTION] frame stats
+
+// Returns the seconds since the previous lap and starts the next one. Costs nothing while no clock
+// is set.
+double FrameStatsLap()
+{
+    if (GImNodes->Io.GetTime == NULL)
+    {
+        return 0.0;
+    }
+
+    const double now = GImNodes->Io.GetTime();
+    const double lap = now - GImNodes->FrameStatsTime;
+    GImNodes->FrameStatsTime = now;
+    return lap;
+}
+
 } // namespace
 } // namespace IMNODES_NAMESPACE
 
@@ -1923,7 +2114,16 @@ ImNodesIO::LinkDetachWithModifierClick::LinkDetachWithModifierClick() : Modifier
 
 ImNodesIO::ImNodesIO()
     : EmulateThreeButtonMouse(), LinkDetachWithModifierClick(),
-      AltMouseButton(ImGuiMouseButton_Middle), AutoPanningSpeed(1000.0f)
+      AltMouseButton(ImGuiMouseButton_Middle), AutoPanningSpeed(1000.0f), ZoomWheelFactor(1.1f),
+      ZoomMin(0.1f), ZoomMax(2.f), GetTime(NULL)
+{
+}
+
+ImNodesFrameStats::ImNodesFrameStats()
+    : NodeCount(0), PinCount(0), LinkCount(0), DrawnNodeCount(0), DrawnLinkCount(0),
+      ChannelCount(0), ChannelCapacity(0), DrawCmdCount(0), VertexCount(0), SubmissionTime(0.0),
+      HoverTime(0.0), DrawTime(0.0), InteractionTime(0.0), DepthSortTime(0.0),
+      PoolUpdateTime(0.0), MergeTime(0.0)
 {
 }
 
@@ -1932,8 +2132,8 @@ ImNodesStyle::ImNodesStyle()
       LinkThickness(3.f), LinkLineSegmentsPerLength(0.1f), LinkHoverDistance(10.f),
       PinCircleRadius(4.f), PinQuadSideLength(7.f), PinTriangleSideLength(9.5),
       PinLineThickness(1.f), PinHoverRadius(10.f), PinOffset(0.f), MiniMapPadding(8.0f, 8.0f),
-      MiniMapOffset(4.0f, 4.0f), Flags(ImNodesStyleFlags_NodeOutline | ImNodesStyleFlags_GridLines),
-      Colors()
+      MiniMapOffset(4.0f, 4.0f), NodeDetailZoom(0.5f), LinkDetailZoom(0.5f),
+      Flags(ImNodesStyleFlags_NodeOutline | ImNodesStyleFlags_GridLines), Colors()
 {
 }
 
@@ -1994,14 +2194,32 @@ void EditorContextMoveToNode(const int node_id)
     ImNodesEditorContext& editor = EditorContextGet();
     ImNodeData&           node = ObjectPoolFindOrCreateObject(editor.Nodes, node_id);
 
-    editor.Panning.x = -node.Origin.x;
-    editor.Panning.y = -node.Origin.y;
+    editor.Panning.x = -node.Origin.x * editor.Zoom;
+    editor.Panning.y = -node.Origin.y * editor.Zoom;
+}
+
+float EditorContextGetZoom()
+{
+    const ImNodesEditorContext& editor = EditorContextGet();
+    return editor.Zoom;
+}
+
+void EditorContextSetZoom(const float zoom, const ImVec2& pivot)
+{
+    assert(zoom > 0.f);
+
+    ImNodesEditorContext& editor = EditorContextGet();
+    const ImVec2          grid_pivot = EditorSpaceToGridSpace(editor, pivot);
+    editor.Zoom = zoom;
+    editor.Panning = pivot - grid_pivot * zoom;
 }
 
 void SetImGuiContext(ImGuiContext* ctx) { ImGui::SetCurrentContext(ctx); }
 
 ImNodesIO& GetIO() { return GImNodes->Io; }
 
+const ImNodesFrameStats& GetFrameStats() { return GImNodes->FrameStats; }
+
 ImNodesStyle& GetStyle() { return GImNodes->Style; }
 
 void StyleColorsDark()
@@ -2135,14 +2353,18 @@ void BeginNodeEditor()
     ObjectPoolReset(editor.Pins);
     ObjectPoolReset(editor.Links);
 
+    const float pin_grid_cell_size = ImMax(GImNodes->Style.PinHoverRadius, 1.0f);
+    if (editor.PinGrid.CellSize != pin_grid_cell_size)
+    {
+        SpatialGridClear(editor.PinGrid, pin_grid_cell_size);
+    }
+
     GImNodes->HoveredNodeIdx.Reset();
     GImNodes->HoveredLinkIdx.Reset();
     GImNodes->HoveredPinIdx.Reset();
     GImNodes->DeletedLinkIdx.Reset();
     GImNodes->SnapLinkIdx.Reset();
 
-    GImNodes->NodeIndicesOverlappingWithMouse.clear();
-
     GImNodes->ImNodesUIState = ImNodesUIState_None;
 
     GImNodes->MousePos = ImGui::GetIO().MousePos;
@@ -2174,6 +2396,13 @@ void BeginNodeEditor()
                 ImGuiWindowFlags_NoScrollWithMouse);
         GImNodes->CanvasOriginScreenSpace = ImGui::GetCursorScreenPos();
 
+        // The nodes' content scales with the zoom, like the nodes themselves
+        ImGui::SetWindowFontScale(editor.Zoom);
+        const ImGuiStyle& imgui_style = ImGui::GetStyle();
+        ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, imgui_style.ItemSpacing * editor.Zoom);
+        ImGui::PushStyleVar(
+            ImGuiStyleVar_ItemInnerSpacing, imgui_style.ItemInnerSpacing * editor.Zoom);
+
         // NOTE: we have to fetch the canvas draw list *after* we call
         // BeginChild(), otherwise the ImGui UI elements are going to be
         // rendered into the parent window draw list.
@@ -2184,12 +2413,25 @@ void BeginNodeEditor()
             GImNodes->CanvasRectScreenSpace = ImRect(
                 EditorSpaceToScreenSpace(ImVec2(0.f, 0.f)), EditorSpaceToScreenSpace(canvas_size));
 
+            // A node's pins and outline reach past its rectangle by up to the pin offset and pin
+            // size
+            const ImNodesStyle& style = GImNodes->Style;
+            const float         pin_size = ImMax(
+                style.PinCircleRadius, ImMax(style.PinQuadSideLength, style.PinTriangleSideLength));
+            const float node_margin = ImFabs(style.PinOffset) + pin_size + style.PinLineThickness +
+                                      style.NodeBorderThickness;
+            GImNodes->NodeCullRectScreenSpace = GImNodes->CanvasRectScreenSpace;
+            GImNodes->NodeCullRectScreenSpace.Expand(node_margin * editor.Zoom);
+
             if (GImNodes->Style.Flags & ImNodesStyleFlags_GridLines)
             {
                 DrawGrid(editor, canvas_size);
             }
         }
     }
+
+    GImNodes->FrameStats = ImNodesFrameStats();
+    FrameStatsLap();
 }
 
 void EndNodeEditor()
@@ -2198,6 +2440,9 @@ void EndNodeEditor()
     GImNodes->CurrentScope = ImNodesScope_None;
 
     ImNodesEditorContext& editor = EditorContextGet();
+    ImNodesFrameStats&    stats = GImNodes->FrameStats;
+
+    stats.SubmissionTime = FrameStatsLap();
 
     bool no_grid_content = editor.GridContentBounds.IsInverted();
     if (no_grid_content)
@@ -2225,32 +2470,40 @@ void EndNodeEditor()
     {
         // Pins needs some special care. We need to check the depth stack to see which pins are
         // being occluded by other nodes.
-        ResolveOccludedPins(editor, GImNodes->OccludedPinIndices);
+        FindPinsNearMouse(editor, GImNodes->PinIndicesNearMouse);
+        ResolveOccludedPins(editor, GImNodes->PinIndicesNearMouse, GImNodes->OccludedPins);
 
-        GImNodes->HoveredPinIdx = ResolveHoveredPin(editor.Pins, GImNodes->OccludedPinIndices);
+        GImNodes->HoveredPinIdx = ResolveHoveredPin(
+            editor.Pins, GImNodes->PinIndicesNearMouse, GImNodes->OccludedPins);
 
         if (!GImNodes->HoveredPinIdx.HasValue())
         {
             // Resolve which node is actually on top and being hovered using the depth stack.
-            GImNodes->HoveredNodeIdx = ResolveHoveredNode(editor.NodeDepthOrder);
+            GImNodes->HoveredNodeIdx = ResolveHoveredNode(editor);
         }
 
         // We don't check for hovered pins here, because if we want to detach a link by clicking and
         // dragging, we need to have both a link and pin hovered.
         if (!GImNodes->HoveredNodeIdx.HasValue())
         {
-            GImNodes->HoveredLinkIdx = ResolveHoveredLink(editor.Links, editor.Pins);
+            GImNodes->HoveredLinkIdx = ResolveHoveredLink(editor);
         }
     }
 
-    for (int node_idx = 0; node_idx < editor.Nodes.Pool.size(); ++node_idx)
+    stats.HoverTime = FrameStatsLap();
+
+    // Nodes and links outside of the canvas aren't drawn. EndNode() already dropped the nodes.
+    for (int submission_idx = 0; submission_idx < GImNodes->NodeIdxSubmissionOrder.Size;
+         ++submission_idx)
     {
-        if (editor.Nodes.InUse[node_idx])
-        {
-            DrawListActivateNodeBackground(node_idx);
-            DrawNode(editor, node_idx);
-        }
+        const int node_idx = GImNodes->NodeIdxSubmissionOrder[submission_idx];
+        DrawListActivateNodeBackground(node_idx);
+        DrawNode(editor, node_idx);
     }
+    stats.DrawnNodeCount = GImNodes->NodeIdxSubmissionOrder.Size;
+
+    ImRect link_cull_rect = GImNodes->CanvasRectScreenSpace;
+    link_cull_rect.Expand(GImNodes->Style.LinkThickness * editor.Zoom);
 
     // In order to render the links underneath the nodes, we want to first select the bottom draw
     // channel.
@@ -2258,9 +2511,17 @@ void EndNodeEditor()
 
     for (int link_idx = 0; link_idx < editor.Links.Pool.size(); ++link_idx)
     {
-        if (editor.Links.InUse[link_idx])
+        if (!editor.Links.InUse[link_idx])
+        {
+            continue;
+        }
+
+        const ImLinkData& link = editor.Links.Pool[link_idx];
+        if (link_cull_rect.Overlaps(GetCubicBezierBounds(
+                editor.Pins.Pool[link.StartPinIdx].Pos, editor.Pins.Pool[link.EndPinIdx].Pos)))
         {
             DrawLink(editor, link_idx);
+            ++stats.DrawnLinkCount;
         }
     }
 
@@ -2276,6 +2537,8 @@ void EndNodeEditor()
         MiniMapUpdate();
     }
 
+    stats.DrawTime = FrameStatsLap();
+
     // Handle node graph interaction
 
     if (!IsMiniMapHovered())
@@ -2317,24 +2580,72 @@ void EndNodeEditor()
                 direction * ImGui::GetIO().DeltaTime * GImNodes->Io.AutoPanningSpeed;
             editor.Panning += editor.AutoPanningDelta;
         }
+
+        // The mouse wheel zooms around the mouse, unless it's being used by a widget in a node
+        if (GImNodes->AltMouseScrollDelta != 0.f && MouseInCanvas() &&
+            editor.ClickInteraction.Type != ImNodesClickInteractionType_ImGuiItem)
+        {
+            const ImNodesIO& io = GImNodes->Io;
+            const float      zoom = ImClamp(
+                editor.Zoom * ImPow(io.ZoomWheelFactor, GImNodes->AltMouseScrollDelta),
+                io.ZoomMin,
+                io.ZoomMax);
+            EditorContextSetZoom(zoom, GImNodes->MousePos - GImNodes->CanvasOriginScreenSpace);
+        }
     }
     ClickInteractionUpdate(editor);
 
+    stats.InteractionTime = FrameStatsLap();
+
     // At this point, draw commands have been issued for all nodes (and pins). Update the node pool
     // to detect unused node slots and remove those indices from the depth stack before sorting the
     // node draw commands by depth.
     ObjectPoolUpdate(editor.Nodes);
     ObjectPoolUpdate(editor.Pins);
 
+    // The pin a link was dragged from may have been freed along with its node this frame, there's
+    // nothing left for IsLinkDropped() and IsLinkCreated() to report then
+    const ImNodesUIState link_states =
+        ImNodesUIState_LinkStarted | ImNodesUIState_LinkDropped | ImNodesUIState_LinkCreated;
+    if ((GImNodes->ImNodesUIState & link_states) != 0 &&
+        !ObjectPoolIsCurrent(
+            editor.Pins,
+            editor.ClickInteraction.LinkCreation.StartPinIdx,
+            editor.ClickInteraction.LinkCreation.StartPinGeneration))
+    {
+        GImNodes->ImNodesUIState &= ~link_states;
+    }
+
+    stats.PoolUpdateTime = FrameStatsLap();
+
     DrawListSortChannelsByDepth(editor.NodeDepthOrder);
 
+    stats.DepthSortTime = FrameStatsLap();
+
     // After the links have been rendered, the link pool can be updated as well.
     ObjectPoolUpdate(editor.Links);
 
+    // The slots of freed nodes and links are reused by the next ones created
+    ObjectPoolRemoveFreed(editor.Nodes, editor.SelectedNodeIndices);
+    ObjectPoolRemoveFreed(editor.Links, editor.SelectedLinkIndices);
+
+    stats.PoolUpdateTime += FrameStatsLap();
+    stats.NodeCount = editor.Nodes.Pool.size() - editor.Nodes.FreeList.size();
+    stats.PinCount = editor.Pins.Pool.size() - editor.Pins.FreeList.size();
+    stats.LinkCount = editor.Links.Pool.size() - editor.Links.FreeList.size();
+    stats.ChannelCount = GImNodes->CanvasDrawList->_Splitter._Count;
+
     // Finally, merge the draw channels
     GImNodes->CanvasDrawList->ChannelsMerge();
+    DrawListTrimChannels(editor, stats.ChannelCount);
+
+    stats.MergeTime = FrameStatsLap();
+    stats.ChannelCapacity = GImNodes->CanvasDrawList->_Splitter._Channels.Size;
+    stats.DrawCmdCount = GImNodes->CanvasDrawList->CmdBuffer.Size;
+    stats.VertexCount = GImNodes->CanvasDrawList->VtxBuffer.Size;
 
     // pop style
+    ImGui::PopStyleVar(2);  // pop zoomed item spacing
     ImGui::EndChild();      // end scrolling region
     ImGui::PopStyleColor(); // pop child window background color
     ImGui::PopStyleVar();   // pop window padding
@@ -2382,6 +2693,7 @@ void BeginNode(const int node_id)
     GImNodes->CurrentNodeIdx = node_idx;
 
     ImNodeData& node = editor.Nodes.Pool[node_idx];
+    node.PinIndices.resize(0);
     node.ColorStyle.Background = GImNodes->Style.Colors[ImNodesCol_NodeBackground];
     node.ColorStyle.BackgroundHovered = GImNodes->Style.Colors[ImNodesCol_NodeBackgroundHovered];
     node.ColorStyle.BackgroundSelected = GImNodes->Style.Colors[ImNodesCol_NodeBackgroundSelected];
@@ -2389,18 +2701,25 @@ void BeginNode(const int node_id)
     node.ColorStyle.Titlebar = GImNodes->Style.Colors[ImNodesCol_TitleBar];
     node.ColorStyle.TitlebarHovered = GImNodes->Style.Colors[ImNodesCol_TitleBarHovered];
     node.ColorStyle.TitlebarSelected = GImNodes->Style.Colors[ImNodesCol_TitleBarSelected];
-    node.LayoutStyle.CornerRounding = GImNodes->Style.NodeCornerRounding;
-    node.LayoutStyle.Padding = GImNodes->Style.NodePadding;
-    node.LayoutStyle.BorderThickness = GImNodes->Style.NodeBorderThickness;
+    node.LayoutStyle.CornerRounding = GImNodes->Style.NodeCornerRounding * editor.Zoom;
+    node.LayoutStyle.Padding = GImNodes->Style.NodePadding * editor.Zoom;
+    node.LayoutStyle.BorderThickness = GImNodes->Style.NodeBorderThickness * editor.Zoom;
 
     // ImGui::SetCursorPos sets the cursor position, local to the current widget
     // (in this case, the child object started in BeginNodeEditor). Use
     // ImGui::SetCursorScreenPos to set the screen space coordinates directly.
-    ImGui::SetCursorPos(GridSpaceToEditorSpace(editor, GetNodeTitleBarOrigin(node)));
+    ImGui::SetCursorPos(GetNodeTitleBarOrigin(editor, node));
 
     DrawListAddNode(node_idx);
     DrawListActivateCurrentNodeForeground();
 
+    // Zoomed out too far for details, the content is laid out but clipped away. ImGui skips
+    // rendering the widgets outside of the clip rectangle.
+    if (editor.Zoom < GImNodes->Style.NodeDetailZoom)
+    {
+        ImGui::PushClipRect(ImVec2(FLT_MAX, FLT_MAX), ImVec2(FLT_MAX, FLT_MAX), false);
+    }
+
     ImGui::PushID(node.Id);
     ImGui::BeginGroup();
 }
@@ -2416,16 +2735,32 @@ void EndNode()
     ImGui::EndGroup();
     ImGui::PopID();
 
+    if (editor.Zoom < GImNodes->Style.NodeDetailZoom)
+    {
+        ImGui::PopClipRect();
+    }
+
     ImNodeData& node = editor.Nodes.Pool[GImNodes->CurrentNodeIdx];
     node.Rect = GetItemRect();
     node.Rect.Expand(node.LayoutStyle.Padding);
 
     editor.GridContentBounds.Add(node.Origin);
-    editor.GridContentBounds.Add(node.Origin + node.Rect.GetSize());
+    editor.GridContentBounds.Add(node.Origin + node.Rect.GetSize() / editor.Zoom);
+
+    SpatialGridUpdate(
+        editor.NodeGrid, GImNodes->CurrentNodeIdx, ScreenSpaceToGridSpace(editor, node.Rect));
+
+    DrawListEndNode(GImNodes->NodeCullRectScreenSpace.Overlaps(node.Rect));
 
-    if (node.Rect.Contains(GImNodes->MousePos))
+    // The pins sit on the node's edges, so their positions are known once the node's size is
+    for (int i = 0; i < node.PinIndices.size(); ++i)
     {
-        GImNodes->NodeIndicesOverlappingWithMouse.push_back(GImNodes->CurrentNodeIdx);
+        const int  pin_idx = node.PinIndices[i];
+        ImPinData& pin = editor.Pins.Pool[pin_idx];
+        pin.Pos = GetScreenSpacePinCoordinates(editor, node.Rect, pin.AttributeRect, pin.Type);
+
+        SpatialGridUpdate(
+            editor.PinGrid, pin_idx, ScreenSpaceToGridSpace(editor, ImRect(pin.Pos, pin.Pos)));
     }
 }
 
@@ -2438,6 +2773,27 @@ ImVec2 GetNodeDimensions(int node_id)
     return node.Rect.GetSize();
 }
 
+bool IsNodeVisible(const int node_id)
+{
+    const ImNodesEditorContext& editor = EditorContextGet();
+    const int                   node_idx = ObjectPoolFind(editor.Nodes, node_id);
+    if (node_idx == -1)
+    {
+        return true;
+    }
+
+    if (editor.Zoom < GImNodes->Style.NodeDetailZoom)
+    {
+        return false;
+    }
+
+    // The node's rectangle starts at its origin. Panning or moving the node since last frame moved
+    // the origin, not the rectangle.
+    const ImNodeData& node = editor.Nodes.Pool[node_idx];
+    const ImVec2      min = GridSpaceToScreenSpace(editor, node.Origin);
+    return GImNodes->CanvasRectScreenSpace.Overlaps(ImRect(min, min + node.Rect.GetSize()));
+}
+
 void BeginNodeTitleBar()
 {
     assert(GImNodes->CurrentScope == ImNodesScope_Node);
@@ -2455,7 +2811,7 @@ void EndNodeTitleBar()
 
     ImGui::ItemAdd(GetNodeTitleRect(node), ImGui::GetID("title_bar"));
 
-    ImGui::SetCursorPos(GridSpaceToEditorSpace(editor, GetNodeContentOrigin(node)));
+    ImGui::SetCursorPos(GetNodeContentOrigin(editor, node));
 }
 
 void BeginInputAttribute(const int id, const ImNodesPinShape shape)
@@ -2594,6 +2950,10 @@ static const ImNodesStyleVarInfo GStyleVarInfo[] = {
     {ImGuiDataType_Float, 2, (ImU32)IM_OFFSETOF(ImNodesStyle, MiniMapPadding)},
     // ImNodesStyleVar_MiniMapOffset
     {ImGuiDataType_Float, 2, (ImU32)IM_OFFSETOF(ImNodesStyle, MiniMapOffset)},
+    // ImNodesStyleVar_NodeDetailZoom
+    {ImGuiDataType_Float, 1, (ImU32)IM_OFFSETOF(ImNodesStyle, NodeDetailZoom)},
+    // ImNodesStyleVar_LinkDetailZoom
+    {ImGuiDataType_Float, 1, (ImU32)IM_OFFSETOF(ImNodesStyle, LinkDetailZoom)},
 };
 
 static const ImNodesStyleVarInfo* GetStyleVarInfo(ImNodesStyleVar idx)
@@ -3030,7 +3390,16 @@ void NodeLineHandler(ImNodesEditorContext& editor, const char* const line)
 
 void EditorLineHandler(ImNodesEditorContext& editor, const char* const line)
 {
-    (void)sscanf(line, "panning=%f,%f", &editor.Panning.x, &editor.Panning.y);
+    if (sscanf(line, "panning=%f,%f", &editor.Panning.x, &editor.Panning.y) != 2 &&
+        strncmp(line, "zoom=", 5) == 0)
+    {
+        // A damaged zoom would scale every coordinate, NaN fails the comparison and is reset too
+        const ImNodesIO& io = GImNodes->Io;
+        float            zoom;
+        editor.Zoom = sscanf(line + 5, "%f", &zoom) == 1 && zoom == zoom
+                          ? ImClamp(zoom, io.ZoomMin, io.ZoomMax)
+                          : 1.f;
+    }
 }
 } // namespace
 
@@ -3051,7 +3420,10 @@ const char* SaveEditorStateToIniString(
     GImNodes->TextBuffer.reserve(64 * editor.Nodes.Pool.size());
 
     GImNodes->TextBuffer.appendf(
-        "[editor]\npanning=%i,%i\n", (int)editor.Panning.x, (int)editor.Panning.y);
+        "[editor]\npanning=%i,%i\nzoom=%g\n",
+        (int)editor.Panning.x,
+        (int)editor.Panning.y,
+        editor.Zoom);
 
     for (int i = 0; i < editor.Nodes.Pool.size(); i++)
     {
@@ -68,6 +68,8 @@ enum ImNodesStyleVar_
     ImNodesStyleVar_PinOffset,
     ImNodesStyleVar_MiniMapPadding,
     ImNodesStyleVar_MiniMapOffset,
+    ImNodesStyleVar_NodeDetailZoom,
+    ImNodesStyleVar_LinkDetailZoom,
     ImNodesStyleVar_COUNT
 };
 
@@ -141,9 +143,56 @@ struct ImNodesIO
     // Panning speed when dragging an element and mouse is outside the main editor view.
     float AutoPanningSpeed;
 
+    // Turning the mouse wheel over the canvas zooms around the mouse by this factor per step,
+    // within ZoomMin and ZoomMax.
+    float ZoomWheelFactor;
+    float ZoomMin;
+    float ZoomMax;
+
+    // Clock returning the time in seconds. Set to NULL by default. When set, EndNodeEditor() times
+    // each phase of the frame and publishes the result through GetFrameStats().
+    double (*GetTime)();
+
     ImNodesIO();
 };
 
+// Work done by the last BeginNodeEditor()/EndNodeEditor() pair. Times are in seconds and only
+// measured while ImNodesIO::GetTime is set, the counters are always filled in.
+struct ImNodesFrameStats
+{
+    int NodeCount;
+    int PinCount;
+    int LinkCount;
+    // Nodes and links drawn, the others were outside of the canvas
+    int DrawnNodeCount;
+    int DrawnLinkCount;
+    // Draw list channels before they were merged, two per drawn node plus the grid and click
+    // interaction. The capacity is how many the canvas draw list keeps for the following frames.
+    int ChannelCount;
+    int ChannelCapacity;
+    // Draw commands and vertices in the canvas draw list after merging the channels
+    int DrawCmdCount;
+    int VertexCount;
+
+    // From the end of BeginNodeEditor() to the start of EndNodeEditor(): the user's BeginNode(),
+    // attribute and Link() calls
+    double SubmissionTime;
+    // Resolving the hovered pin, node and link
+    double HoverTime;
+    // Drawing the nodes, links and mini-map
+    double DrawTime;
+    // Starting and updating click interactions
+    double InteractionTime;
+    // Sorting the node draw channels by depth
+    double DepthSortTime;
+    // Releasing the nodes, pins and links that weren't submitted this frame
+    double PoolUpdateTime;
+    // Merging the draw channels into the canvas draw list
+    double MergeTime;
+
+    ImNodesFrameStats();
+};
+
 struct ImNodesStyle
 {
     float GridSpacing;
@@ -181,6 +230,12 @@ struct ImNodesStyle
     // Mini-map offset from the screen side.
     ImVec2 MiniMapOffset;
 
+    // Below this zoom, nodes are drawn as plain rectangles without title bar, pins or content. The
+    // content is still submitted for the nodes' sizes, but clipped away.
+    float NodeDetailZoom;
+    // Below this zoom, links are drawn with fewer line segments, in proportion to the zoom.
+    float LinkDetailZoom;
+
     // By default, ImNodesStyleFlags_NodeOutline and ImNodesStyleFlags_Gridlines are enabled.
     ImNodesStyleFlags Flags;
     // Set these mid-frame using Push/PopColorStyle. You can index this color array with with a
@@ -236,9 +291,17 @@ void                  EditorContextSet(ImNodesEditorContext*);
 ImVec2                EditorContextGetPanning();
 void                  EditorContextResetPanning(const ImVec2& pos);
 void                  EditorContextMoveToNode(const int node_id);
+// The editor's zoom, the size of a grid space unit in screen space. 1 by default. Node sizes, style
+// sizes and the node content's font scale along with it.
+float                 EditorContextGetZoom();
+// Sets the zoom, keeping the grid position under the pivot in place. The pivot is in editor space.
+void                  EditorContextSetZoom(const float zoom, const ImVec2& pivot = ImVec2());
 
 ImNodesIO& GetIO();
 
+// Statistics of the last frame, valid after EndNodeEditor().
+const ImNodesFrameStats& GetFrameStats();
+
 // Returns the global style struct. See the struct declaration for default values.
 ImNodesStyle& GetStyle();
 // Style presets matching the dear imgui styles of the same name.
@@ -272,6 +335,13 @@ void EndNode();
 
 ImVec2 GetNodeDimensions(int id);
 
+// Returns whether the node's content is seen this frame: the node is inside the canvas, judged by
+// its current position and the size it had last frame, and the editor is zoomed in to at least
+// ImNodesStyle::NodeDetailZoom. Nodes submitted for the first time count as visible. Call it
+// between BeginNodeEditor() and EndNodeEditor() to skip expensive content of nodes nobody can see,
+// keeping the node's size the same.
+bool IsNodeVisible(int id);
+
 // Place your node title bar content (such as the node title, using ImGui::Text) between the
 // following function calls. These functions have to be called before adding any attributes, or the
 // layout of the node will be incorrect.
@@ -14,6 +14,7 @@
 // [SECTION] internal enums
 // [SECTION] internal data structures
 // [SECTION] global and editor context structs
+// [SECTION] spatial grid implementation
 // [SECTION] object pool implementation
 
 struct ImNodesContext;
@@ -83,10 +84,41 @@ struct ImObjectPool
 {
     ImVector<T>    Pool;
     ImVector<bool> InUse;
+    // Freed slots, the lowest index last so that it's reused first
     ImVector<int>  FreeList;
-    ImGuiStorage   IdMap;
+    // Bumped each time a slot is freed, an index saved with its generation is stale once they
+    // differ. Not shrunk with the pool.
+    ImVector<int>  Generations;
+    // Open addressing table from id to index, kept at most half full. An empty slot has index -1.
+    ImVector<int>  TableIds;
+    ImVector<int>  TableIndices;
+    // Slots flagged in use since the last ObjectPoolReset()
+    int            InUseCount;
+
+    ImObjectPool()
+        : Pool(), InUse(), FreeList(), Generations(), TableIds(), TableIndices(), InUseCount(0)
+    {
+    }
 
-    ImObjectPool() : Pool(), InUse(), FreeList(), IdMap() {}
+    ~ImObjectPool()
+    {
+        // ImVector doesn't destruct its elements. Slots on the free list were destructed when
+        // they were freed.
+        ImBitVector freed;
+        freed.Create(Pool.Size);
+        for (int i = 0; i < FreeList.Size; ++i)
+        {
+            freed.SetBit(FreeList[i]);
+        }
+
+        for (int i = 0; i < Pool.Size; ++i)
+        {
+            if (!freed.TestBit(i))
+            {
+                (Pool.Data + i)->~T();
+            }
+        }
+    }
 };
 
 // Emulates std::optional<int> using the sentinel value `INVALID_INDEX`.
@@ -129,6 +161,30 @@ private:
     int _Index;
 };
 
+struct ImCubicBezier
+{
+    ImVec2 P0, P1, P2, P3;
+    int    NumSegments;
+};
+
+// A link's curve, kept until its pins move relative to each other. Points holds the curve
+// tessellated into NumSegments lines. Everything is in screen space.
+struct ImLinkGeometry
+{
+    ImVec2               StartPos, EndPos;
+    ImNodesAttributeType StartType; // None until the geometry is first computed
+    float                SegmentsPerLength;
+    ImCubicBezier        Bezier;
+    ImRect               Rect; // Contains the control points, and so the curve
+    ImVector<ImVec2>     Points;
+
+    ImLinkGeometry()
+        : StartPos(), EndPos(), StartType(ImNodesAttributeType_None), SegmentsPerLength(0.0f),
+          Bezier(), Rect(), Points()
+    {
+    }
+};
+
 struct ImNodeData
 {
     int    Id;
@@ -195,7 +251,52 @@ struct ImLinkData
         ImU32 Base, Hovered, Selected;
     } ColorStyle;
 
-    ImLinkData(const int link_id) : Id(link_id), StartPinIdx(), EndPinIdx(), ColorStyle() {}
+    ImLinkGeometry Geometry;
+
+    ImLinkData(const int link_id)
+        : Id(link_id), StartPinIdx(), EndPinIdx(), ColorStyle(), Geometry()
+    {
+    }
+};
+
+// A uniform grid over grid space for finding the items near a point or inside a rectangle without
+// testing all of them. An item is kept in every cell its rectangle touches. Cells are found through
+// an open addressing table keyed by their coordinates and stay allocated once created.
+struct ImSpatialGrid
+{
+    struct CellRange
+    {
+        int MinX, MinY, MaxX, MaxY;
+
+        CellRange() : MinX(0), MinY(0), MaxX(-1), MaxY(-1) {}
+        CellRange(const int min_x, const int min_y, const int max_x, const int max_y)
+            : MinX(min_x), MinY(min_y), MaxX(max_x), MaxY(max_y)
+        {
+        }
+
+        inline bool IsEmpty() const { return MinX > MaxX || MinY > MaxY; }
+
+        inline bool operator==(const CellRange& rhs) const
+        {
+            return MinX == rhs.MinX && MinY == rhs.MinY && MaxX == rhs.MaxX && MaxY == rhs.MaxY;
+        }
+    };
+
+    float                   CellSize;
+    ImVector<ImU64>         TableKeys;
+    ImVector<int>           TableCells; // Index into Cells, -1 for an unused slot
+    ImVector<ImVector<int>> Cells;      // The items in each cell
+    ImVector<CellRange>     ItemCells;  // The cells each item is in, by item index
+
+    ImSpatialGrid() : CellSize(256.0f), TableKeys(), TableCells(), Cells(), ItemCells() {}
+
+    ~ImSpatialGrid()
+    {
+        for (int i = 0; i < Cells.Size; ++i)
+        {
+            Cells[i].clear();
+        }
+    }
 };
 
 struct ImClickInteractionState
@@ -207,6 +308,8 @@ struct ImClickInteractionState
         int                     StartPinIdx;
         ImOptionalIndex         EndPinIdx;
         ImNodesLinkCreationType Type;
+        // The start pin's slot generation, the interaction ends if the pin goes away
+        int StartPinGeneration;
     } LinkCreation;
 
     struct
@@ -252,8 +355,16 @@ struct ImNodesEditorContext
 
     ImVector<int> NodeDepthOrder;
 
+    // Node rectangles in grid space, by node index. Updated as nodes are submitted.
+    ImSpatialGrid NodeGrid;
+    // Pin positions in grid space, by pin index. The cells are PinHoverRadius wide, so the pins in
+    // hover range of the mouse are in the cells around it.
+    ImSpatialGrid PinGrid;
+
     // ui related fields
     ImVec2 Panning;
+    // Screen space size of a grid space unit
+    float  Zoom;
     ImVec2 AutoPanningDelta;
     // Minimum and maximum extents of all content in grid space. Valid after final
     // ImNodes::EndNode() call.
@@ -278,11 +389,19 @@ struct ImNodesEditorContext
     ImRect MiniMapContentScreenSpace;
     float  MiniMapScaling;
 
+    // Frames in a row the canvas draw list kept more than twice the draw channels it needed, and
+    // the most channels needed in those frames. Only counted while the editor keeps being drawn
+    // into the same draw list, whose splitter owns the channels.
+    ImDrawList* ChannelTrimDrawList;
+    int         ChannelUnderuseFrames;
+    int         ChannelPeakCount;
+
     ImNodesEditorContext()
-        : Nodes(), Pins(), Links(), Panning(0.f, 0.f), SelectedNodeIndices(), SelectedLinkIndices(),
-          ClickInteraction(), MiniMapEnabled(false), MiniMapSizeFraction(0.0f),
-          MiniMapNodeHoveringCallback(NULL), MiniMapNodeHoveringCallbackUserData(NULL),
-          MiniMapScaling(0.0f)
+        : Nodes(), Pins(), Links(), Panning(0.f, 0.f), Zoom(1.f), SelectedNodeIndices(),
+          SelectedLinkIndices(), ClickInteraction(), MiniMapEnabled(false),
+          MiniMapSizeFraction(0.0f), MiniMapNodeHoveringCallback(NULL),
+          MiniMapNodeHoveringCallbackUserData(NULL), MiniMapScaling(0.0f),
+          ChannelTrimDrawList(NULL), ChannelUnderuseFrames(0), ChannelPeakCount(0)
     {
     }
 };
@@ -294,14 +413,19 @@ struct ImNodesContext
 
     // Canvas draw list and helper state
     ImDrawList*   CanvasDrawList;
+    // Only the nodes on the canvas keep their draw channels, the submission index counts those
     ImGuiStorage  NodeIdxToSubmissionIdx;
     ImVector<int> NodeIdxSubmissionOrder;
+    // Submission index of the node at each depth, the permutation applied to the node channels
+    ImVector<int> DepthToSubmissionIdx;
     ImVector<int> NodeIndicesOverlappingWithMouse;
-    ImVector<int> OccludedPinIndices;
+    ImVector<int> PinIndicesNearMouse;
+    ImBitVector   OccludedPins;
 
-    // Canvas extents
+    // Canvas extents. Nodes outside of the cull rectangle aren't drawn.
     ImVec2 CanvasOriginScreenSpace;
     ImRect CanvasRectScreenSpace;
+    ImRect NodeCullRectScreenSpace;
 
     // Debug helpers
     ImNodesScope CurrentScope;
@@ -313,6 +437,10 @@ struct ImNodesContext
     ImVector<ImNodesStyleVarElement> StyleModifierStack;
     ImGuiTextBuffer                  TextBuffer;
 
+    // Frame statistics, FrameStatsTime is when the phase being measured started
+    ImNodesFrameStats FrameStats;
+    double            FrameStatsTime;
+
     int           CurrentAttributeFlags;
     ImVector<int> AttributeFlagStack;
 
@@ -357,59 +485,472 @@ static inline ImNodesEditorContext& EditorContextGet()
     return *GImNodes->EditorCtx;
 }
 
+// [SECTION] spatial grid implementation
+
+static inline ImU64 SpatialGridKey(const int x, const int y)
+{
+    return (static_cast<ImU64>(static_cast<ImU32>(x)) << 32) | static_cast<ImU32>(y);
+}
+
+static inline ImU32 SpatialGridHash(ImU64 key)
+{
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return static_cast<ImU32>(key);
+}
+
+static inline ImSpatialGrid::CellRange SpatialGridCellRange(
+    const ImSpatialGrid& grid,
+    const ImRect&        rect)
+{
+    const float inv_cell_size = 1.0f / grid.CellSize;
+    return ImSpatialGrid::CellRange(
+        static_cast<int>(ImFloor(rect.Min.x * inv_cell_size)),
+        static_cast<int>(ImFloor(rect.Min.y * inv_cell_size)),
+        static_cast<int>(ImFloor(rect.Max.x * inv_cell_size)),
+        static_cast<int>(ImFloor(rect.Max.y * inv_cell_size)));
+}
+
+// Returns the index of the cell at x, y in grid.Cells, or -1 if it was never created
+static inline int SpatialGridFindCell(const ImSpatialGrid& grid, const int x, const int y)
+{
+    if (grid.TableCells.empty())
+    {
+        return -1;
+    }
+
+    const ImU64 key = SpatialGridKey(x, y);
+    const int   mask = grid.TableCells.Size - 1;
+    for (int slot = static_cast<int>(SpatialGridHash(key)) & mask;; slot = (slot + 1) & mask)
+    {
+        const int cell = grid.TableCells[slot];
+        if (cell == -1 || grid.TableKeys[slot] == key)
+        {
+            return cell;
+        }
+    }
+}
+
+static inline void SpatialGridInsertCell(ImSpatialGrid& grid, const ImU64 key, const int cell)
+{
+    const int mask = grid.TableCells.Size - 1;
+    int       slot = static_cast<int>(SpatialGridHash(key)) & mask;
+    while (grid.TableCells[slot] != -1)
+    {
+        slot = (slot + 1) & mask;
+    }
+
+    grid.TableKeys[slot] = key;
+    grid.TableCells[slot] = cell;
+}
+
+static inline int SpatialGridFindOrCreateCell(ImSpatialGrid& grid, const int x, const int y)
+{
+    int cell = SpatialGridFindCell(grid, x, y);
+    if (cell != -1)
+    {
+        return cell;
+    }
+
+    // Keep the table at most half full
+    if ((grid.Cells.Size + 1) * 2 > grid.TableCells.Size)
+    {
+        ImVector<ImU64> keys;
+        ImVector<int>   cells;
+        keys.swap(grid.TableKeys);
+        cells.swap(grid.TableCells);
+
+        const int new_size = cells.Size == 0 ? 64 : cells.Size * 2;
+        grid.TableKeys.resize(new_size);
+        grid.TableCells.resize(new_size, -1);
+        for (int slot = 0; slot < cells.Size; ++slot)
+        {
+            if (cells[slot] != -1)
+            {
+                SpatialGridInsertCell(grid, keys[slot], cells[slot]);
+            }
+        }
+    }
+
+    cell = grid.Cells.Size;
+    grid.Cells.push_back(ImVector<int>());
+    SpatialGridInsertCell(grid, SpatialGridKey(x, y), cell);
+    return cell;
+}
+
+static inline void SpatialGridRemove(ImSpatialGrid& grid, const int item)
+{
+    if (item >= grid.ItemCells.Size)
+    {
+        return;
+    }
+
+    const ImSpatialGrid::CellRange range = grid.ItemCells[item];
+    for (int y = range.MinY; y <= range.MaxY; ++y)
+    {
+        for (int x = range.MinX; x <= range.MaxX; ++x)
+        {
+            ImVector<int>& cell = grid.Cells[SpatialGridFindCell(grid, x, y)];
+            int* const     elem = cell.find(item);
+            assert(elem != cell.end());
+            *elem = cell.back();
+            cell.pop_back();
+        }
+    }
+
+    grid.ItemCells[item] = ImSpatialGrid::CellRange();
+}
+
+// Removes all items and changes the cell size
+static inline void SpatialGridClear(ImSpatialGrid& grid, const float cell_size)
+{
+    for (int i = 0; i < grid.Cells.Size; ++i)
+    {
+        grid.Cells[i].clear();
+    }
+
+    grid.CellSize = cell_size;
+    grid.TableKeys.clear();
+    grid.TableCells.clear();
+    grid.Cells.clear();
+    grid.ItemCells.clear();
+}
+
+// Moves the item to the cells rect touches. Costs a comparison when they are the same as before.
+static inline void SpatialGridUpdate(ImSpatialGrid& grid, const int item, const ImRect& rect)
+{
+    const ImSpatialGrid::CellRange range = SpatialGridCellRange(grid, rect);
+
+    if (item >= grid.ItemCells.Size)
+    {
+        grid.ItemCells.resize(item + 1, ImSpatialGrid::CellRange());
+    }
+    else if (grid.ItemCells[item] == range)
+    {
+        return;
+    }
+
+    SpatialGridRemove(grid, item);
+
+    for (int y = range.MinY; y <= range.MaxY; ++y)
+    {
+        for (int x = range.MinX; x <= range.MaxX; ++x)
+        {
+            grid.Cells[SpatialGridFindOrCreateCell(grid, x, y)].push_back(item);
+        }
+    }
+
+    grid.ItemCells[item] = range;
+}
+
+// An item spanning several cells is reported from the first of them inside the range only
+static inline void SpatialGridVisitCell(
+    const ImSpatialGrid&            grid,
+    const ImSpatialGrid::CellRange& range,
+    const int                       x,
+    const int                       y,
+    const ImVector<int>&            cell,
+    ImVector<int>&                  items)
+{
+    for (int i = 0; i < cell.Size; ++i)
+    {
+        const ImSpatialGrid::CellRange& item_cells = grid.ItemCells[cell[i]];
+        if (x == ImMax(item_cells.MinX, range.MinX) && y == ImMax(item_cells.MinY, range.MinY))
+        {
+            items.push_back(cell[i]);
+        }
+    }
+}
+
+// Appends each item in a cell touched by rect once. The items' own rectangles still have to be
+// tested against rect.
+static inline void SpatialGridQuery(
+    const ImSpatialGrid& grid,
+    const ImRect&        rect,
+    ImVector<int>&       items)
+{
+    const ImSpatialGrid::CellRange range = SpatialGridCellRange(grid, rect);
+
+    // Large ranges, such as a box selection over a zoomed out graph, are cheaper to answer from
+    // the cells that exist than by looking up every cell they cover
+    const double range_cell_count =
+        double(range.MaxX - range.MinX + 1) * double(range.MaxY - range.MinY + 1);
+    if (range_cell_count > double(grid.Cells.Size))
+    {
+        for (int slot = 0; slot < grid.TableCells.Size; ++slot)
+        {
+            if (grid.TableCells[slot] == -1)
+            {
+                continue;
+            }
+
+            const int x = static_cast<int>(static_cast<ImU32>(grid.TableKeys[slot] >> 32));
+            const int y = static_cast<int>(static_cast<ImU32>(grid.TableKeys[slot]));
+            if (x >= range.MinX && x <= range.MaxX && y >= range.MinY && y <= range.MaxY)
+            {
+                SpatialGridVisitCell(grid, range, x, y, grid.Cells[grid.TableCells[slot]], items);
+            }
+        }
+        return;
+    }
+
+    for (int y = range.MinY; y <= range.MaxY; ++y)
+    {
+        for (int x = range.MinX; x <= range.MaxX; ++x)
+        {
+            const int cell = SpatialGridFindCell(grid, x, y);
+            if (cell != -1)
+            {
+                SpatialGridVisitCell(grid, range, x, y, grid.Cells[cell], items);
+            }
+        }
+    }
+}
+
 // [SECTION] ObjectPool implementation
 
+static inline ImU32 ObjectPoolHash(const int id)
+{
+    ImU32 hash = static_cast<ImU32>(id);
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bU;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35U;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+// Returns the table slot holding id, or the empty slot where it would go
+template<typename T>
+static inline int ObjectPoolFindSlot(const ImObjectPool<T>& objects, const int id)
+{
+    const int mask = objects.TableIndices.Size - 1;
+    int       slot = static_cast<int>(ObjectPoolHash(id)) & mask;
+    while (objects.TableIndices[slot] != -1 && objects.TableIds[slot] != id)
+    {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
 template<typename T>
 static inline int ObjectPoolFind(const ImObjectPool<T>& objects, const int id)
 {
-    const int index = objects.IdMap.GetInt(static_cast<ImGuiID>(id), -1);
-    return index;
+    if (objects.TableIndices.empty())
+    {
+        return -1;
+    }
+
+    return objects.TableIndices[ObjectPoolFindSlot(objects, id)];
 }
 
 template<typename T>
-static inline void ObjectPoolUpdate(ImObjectPool<T>& objects)
+static inline void ObjectPoolTableInsert(ImObjectPool<T>& objects, const int id, const int index)
+{
+    // Keep the table at most half full, the new object is already counted
+    if ((objects.Pool.Size - objects.FreeList.Size) * 2 > objects.TableIndices.Size)
+    {
+        ImVector<int> ids;
+        ImVector<int> indices;
+        ids.swap(objects.TableIds);
+        indices.swap(objects.TableIndices);
+
+        const int new_size = indices.Size == 0 ? 64 : indices.Size * 2;
+        objects.TableIds.resize(new_size);
+        objects.TableIndices.resize(new_size, -1);
+        for (int slot = 0; slot < indices.Size; ++slot)
+        {
+            if (indices[slot] != -1)
+            {
+                const int new_slot = ObjectPoolFindSlot(objects, ids[slot]);
+                objects.TableIds[new_slot] = ids[slot];
+                objects.TableIndices[new_slot] = indices[slot];
+            }
+        }
+    }
+
+    const int slot = ObjectPoolFindSlot(objects, id);
+    objects.TableIds[slot] = id;
+    objects.TableIndices[slot] = index;
+}
+
+// The entries after the removed one move back into the gap unless that would put them before
+// their home slot, so lookups don't need tombstones
+template<typename T>
+static inline void ObjectPoolTableRemove(ImObjectPool<T>& objects, const int id)
 {
-    for (int i = 0; i < objects.InUse.size(); ++i)
+    const int mask = objects.TableIndices.Size - 1;
+    int       hole = ObjectPoolFindSlot(objects, id);
+    assert(objects.TableIndices[hole] != -1);
+
+    for (int slot = (hole + 1) & mask; objects.TableIndices[slot] != -1; slot = (slot + 1) & mask)
+    {
+        const int home = static_cast<int>(ObjectPoolHash(objects.TableIds[slot])) & mask;
+        if (((slot - home) & mask) >= ((slot - hole) & mask))
+        {
+            objects.TableIds[hole] = objects.TableIds[slot];
+            objects.TableIndices[hole] = objects.TableIndices[slot];
+            hole = slot;
+        }
+    }
+
+    objects.TableIndices[hole] = -1;
+}
+
+// Whether an index saved together with the generation of its slot still refers to the same object
+template<typename T>
+static inline bool ObjectPoolIsCurrent(
+    const ImObjectPool<T>& objects,
+    const int              index,
+    const int              generation)
+{
+    return index < objects.Pool.Size && objects.Generations[index] == generation;
+}
+
+// Objects that exist but weren't flagged in use since ObjectPoolReset(). Zero in the common case
+// of every object having been submitted, the pools aren't scanned then.
+template<typename T>
+static inline int ObjectPoolUnusedCount(const ImObjectPool<T>& objects)
+{
+    return objects.Pool.Size - objects.FreeList.Size - objects.InUseCount;
+}
+
+template<typename T>
+static inline bool ObjectPoolIsUnused(const ImObjectPool<T>& objects, const int index)
+{
+    // Slots on the free list aren't in use either, but their id no longer maps to them
+    return !objects.InUse[index] && ObjectPoolFind(objects, objects.Pool[index].Id) == index;
+}
+
+template<typename T>
+static inline void ObjectPoolFreeIndex(ImObjectPool<T>& objects, const int index)
+{
+    ObjectPoolTableRemove(objects, objects.Pool[index].Id);
+    objects.FreeList.push_back(index);
+    ++objects.Generations[index];
+    (objects.Pool.Data + index)->~T();
+}
+
+// Once most of the pool is free, the free slots at its end are dropped and the free list is sorted
+// so that new objects fill the lowest slots. Loops over the pool end at the last object then.
+template<typename T>
+static inline void ObjectPoolCompact(ImObjectPool<T>& objects)
+{
+    if (objects.FreeList.Size * 2 <= objects.Pool.Size)
+    {
+        return;
+    }
+
+    ImBitVector freed;
+    freed.Create(objects.Pool.Size);
+    for (int i = 0; i < objects.FreeList.Size; ++i)
+    {
+        freed.SetBit(objects.FreeList[i]);
+    }
+
+    int size = objects.Pool.Size;
+    while (size > 0 && freed.TestBit(size - 1))
     {
-        const int id = objects.Pool[i].Id;
+        --size;
+    }
 
-        if (!objects.InUse[i] && objects.IdMap.GetInt(id, -1) == i)
+    objects.FreeList.resize(0);
+    for (int i = size - 1; i >= 0; --i)
+    {
+        if (freed.TestBit(i))
         {
-            objects.IdMap.SetInt(id, -1);
             objects.FreeList.push_back(i);
-            (objects.Pool.Data + i)->~T();
         }
     }
+
+    objects.Pool.shrink(size);
+    objects.InUse.shrink(size);
+}
+
+// Drops the indices of objects freed by ObjectPoolUpdate() from a list of indices into the pool
+template<typename T>
+static inline void ObjectPoolRemoveFreed(const ImObjectPool<T>& objects, ImVector<int>& indices)
+{
+    int kept = 0;
+    for (int i = 0; i < indices.Size; ++i)
+    {
+        const int index = indices[i];
+        if (index < objects.InUse.Size && objects.InUse[index])
+        {
+            indices[kept++] = index;
+        }
+    }
+    indices.shrink(kept);
+}
+
+template<typename T>
+static inline void ObjectPoolUpdate(ImObjectPool<T>& objects)
+{
+    int unused_count = ObjectPoolUnusedCount(objects);
+    if (unused_count == 0)
+    {
+        return;
+    }
+
+    for (int i = 0; unused_count > 0 && i < objects.Pool.Size; ++i)
+    {
+        if (ObjectPoolIsUnused(objects, i))
+        {
+            ObjectPoolFreeIndex(objects, i);
+            --unused_count;
+        }
+    }
+
+    ObjectPoolCompact(objects);
 }
 
 template<>
 inline void ObjectPoolUpdate(ImObjectPool<ImNodeData>& nodes)
 {
-    for (int i = 0; i < nodes.InUse.size(); ++i)
+    int unused_count = ObjectPoolUnusedCount(nodes);
+    if (unused_count == 0)
+    {
+        return;
+    }
+
+    ImNodesEditorContext& editor = EditorContextGet();
+    for (int i = 0; unused_count > 0 && i < nodes.Pool.Size; ++i)
     {
-        if (nodes.InUse[i])
+        if (ObjectPoolIsUnused(nodes, i))
         {
-            nodes.Pool[i].PinIndices.clear();
+            SpatialGridRemove(editor.NodeGrid, i);
+            ObjectPoolFreeIndex(nodes, i);
+            --unused_count;
         }
-        else
-        {
-            const int id = nodes.Pool[i].Id;
+    }
 
-            if (nodes.IdMap.GetInt(id, -1) == i)
-            {
-                // Remove node idx form depth stack the first time we detect that this idx slot is
-                // unused
-                ImVector<int>&   depth_stack = EditorContextGet().NodeDepthOrder;
-                const int* const elem = depth_stack.find(i);
-                assert(elem != depth_stack.end());
-                depth_stack.erase(elem);
-
-                nodes.IdMap.SetInt(id, -1);
-                nodes.FreeList.push_back(i);
-                (nodes.Pool.Data + i)->~ImNodeData();
-            }
+    // The depth stack only holds the nodes in use now
+    ObjectPoolRemoveFreed(nodes, editor.NodeDepthOrder);
+    ObjectPoolCompact(nodes);
+}
+
+template<>
+inline void ObjectPoolUpdate(ImObjectPool<ImPinData>& pins)
+{
+    int unused_count = ObjectPoolUnusedCount(pins);
+    if (unused_count == 0)
+    {
+        return;
+    }
+
+    ImNodesEditorContext& editor = EditorContextGet();
+    for (int i = 0; unused_count > 0 && i < pins.Pool.Size; ++i)
+    {
+        if (ObjectPoolIsUnused(pins, i))
+        {
+            SpatialGridRemove(editor.PinGrid, i);
+            ObjectPoolFreeIndex(pins, i);
+            --unused_count;
         }
     }
+
+    ObjectPoolCompact(pins);
 }
 
 template<typename T>
@@ -419,35 +960,59 @@ static inline void ObjectPoolReset(ImObjectPool<T>& objects)
     {
         memset(objects.InUse.Data, 0, objects.InUse.size_in_bytes());
     }
+    objects.InUseCount = 0;
+}
+
+// Takes the lowest free slot, or a new one, and constructs the object in it
+template<typename T>
+static inline int ObjectPoolCreateIndex(ImObjectPool<T>& objects, const int id)
+{
+    int index;
+    if (objects.FreeList.empty())
+    {
+        index = objects.Pool.size();
+        IM_ASSERT(objects.Pool.size() == objects.InUse.size());
+        const int new_size = objects.Pool.size() + 1;
+        objects.Pool.resize(new_size);
+        objects.InUse.resize(new_size, false);
+        if (objects.Generations.Size < new_size)
+        {
+            objects.Generations.push_back(0);
+        }
+    }
+    else
+    {
+        index = objects.FreeList.back();
+        objects.FreeList.pop_back();
+    }
+    IM_PLACEMENT_NEW(objects.Pool.Data + index) T(id);
+    ObjectPoolTableInsert(objects, id, index);
+    return index;
+}
+
+// Flags the object in use, counted once per frame
+template<typename T>
+static inline void ObjectPoolMarkInUse(ImObjectPool<T>& objects, const int index)
+{
+    if (!objects.InUse[index])
+    {
+        objects.InUse[index] = true;
+        ++objects.InUseCount;
+    }
 }
 
 template<typename T>
 static inline int ObjectPoolFindOrCreateIndex(ImObjectPool<T>& objects, const int id)
 {
-    int index = objects.IdMap.GetInt(static_cast<ImGuiID>(id), -1);
+    int index = ObjectPoolFind(objects, id);
 
     // Construct new object
     if (index == -1)
     {
-        if (objects.FreeList.empty())
-        {
-            index = objects.Pool.size();
-            IM_ASSERT(objects.Pool.size() == objects.InUse.size());
-            const int new_size = objects.Pool.size() + 1;
-            objects.Pool.resize(new_size);
-            objects.InUse.resize(new_size);
-        }
-        else
-        {
-            index = objects.FreeList.back();
-            objects.FreeList.pop_back();
-        }
-        IM_PLACEMENT_NEW(objects.Pool.Data + index) T(id);
-        objects.IdMap.SetInt(static_cast<ImGuiID>(id), index);
+        index = ObjectPoolCreateIndex(objects, id);
     }
 
-    // Flag it as used
-    objects.InUse[index] = true;
+    ObjectPoolMarkInUse(objects, index);
 
     return index;
 }
@@ -455,33 +1020,18 @@ static inline int ObjectPoolFindOrCreateIndex(ImObjectPool<T>& objects, const in
 template<>
 inline int ObjectPoolFindOrCreateIndex(ImObjectPool<ImNodeData>& nodes, const int node_id)
 {
-    int node_idx = nodes.IdMap.GetInt(static_cast<ImGuiID>(node_id), -1);
+    int node_idx = ObjectPoolFind(nodes, node_id);
 
     // Construct new node
     if (node_idx == -1)
     {
-        if (nodes.FreeList.empty())
-        {
-            node_idx = nodes.Pool.size();
-            IM_ASSERT(nodes.Pool.size() == nodes.InUse.size());
-            const int new_size = nodes.Pool.size() + 1;
-            nodes.Pool.resize(new_size);
-            nodes.InUse.resize(new_size);
-        }
-        else
-        {
-            node_idx = nodes.FreeList.back();
-            nodes.FreeList.pop_back();
-        }
-        IM_PLACEMENT_NEW(nodes.Pool.Data + node_idx) ImNodeData(node_id);
-        nodes.IdMap.SetInt(static_cast<ImGuiID>(node_id), node_idx);
+        node_idx = ObjectPoolCreateIndex(nodes, node_id);
 
         ImNodesEditorContext& editor = EditorContextGet();
         editor.NodeDepthOrder.push_back(node_idx);
     }
 
-    // Flag node as used
-    nodes.InUse[node_idx] = true;
+    ObjectPoolMarkInUse(nodes, node_idx);
 
     return node_idx;
 }